@@ -18,6 +18,28 @@
 #include "string.h"
 #include "time.h"
 
+// word-parallel rectangle scans in the hit tests and recolouring
+// use the widest vector unit the compiler generates code for
+#if defined(__AVX2__)
+#define _RECTSCANAVX2
+#include "immintrin.h"
+#elif defined(__SSE2__)
+#define _RECTSCANSSE2
+#include "emmintrin.h"
+#endif
+
+// several JuliaEngine objects computing at the same time, each
+// on its own thread: the engine state becomes thread-local
+//#define _MULTIENGINE
+
+#ifdef _MULTIENGINE
+#include <thread>
+#include <mutex>
+#define ENGINELOCAL thread_local
+#else
+#define ENGINELOCAL
+#endif
+
 
 // used floating type
 // comment out or in what is needed
@@ -28,6 +50,11 @@
 //#define _FPA
 //#define _F107
 //#define _F161
+//#define _DD
+// fixed point: 64 bit integer part and 64, 128 or 192 fractional bits
+//#define _FIXPOINT1
+//#define _FIXPOINT2
+//#define _FIXPOINT3
 
 
 // typedefs
@@ -109,6 +136,280 @@ f161_o operator*(int,const f161_o);
 double specialFloor161(const f161_o);
 #endif
 
+#ifdef _DD
+// built-in double-double: value hi+lo, hi being the value rounded
+// to double. Products use fused multiply-add. All operations are exact
+// as long as every value fits into 104 bits (see check_bitprecision).
+// Needs IEEE arithmetic, i.e. no -ffast-math; best with hardware FMA
+// (-mfma or -march=native)
+struct DD {
+	double hi,lo;
+	
+	DD();
+	DD(const double);
+	DD(const int);
+	
+	explicit operator double() const;
+};
+typedef DD NTYP;
+typedef DD *PDD;
+const char NNTYPSTR[]="dd_";
+const char NTS[]="DD";
+inline DD operator+(const DD&,const DD&);
+inline DD operator-(const DD&,const DD&);
+inline DD operator-(const DD&);
+inline DD operator*(const DD&,const DD&);
+inline DD operator*(const int,const DD&);
+inline bool operator<(const DD&,const DD&);
+inline bool operator>(const DD&,const DD&);
+inline bool operator<=(const DD&,const DD&);
+inline bool operator>=(const DD&,const DD&);
+inline bool operator==(const DD&,const DD&);
+inline bool operator!=(const DD&,const DD&);
+inline void minimaxDDAB(DD&,DD&,const DD&,const DD&);
+inline void minimaxDDABCD(DD&,DD&,const DD&,const DD&,const DD&,const DD&);
+inline double floorDD(const DD&);
+#endif
+
+#if defined(_FIXPOINT1) || defined(_FIXPOINT2) || defined(_FIXPOINT3)
+#define _FIXPOINT
+#ifdef _FIXPOINT1
+const int32_t FIXPOINTLIMBS=1;
+const char NNTYPSTR[]="fx1_";
+const char NTS[]="X1";
+#endif
+#ifdef _FIXPOINT2
+const int32_t FIXPOINTLIMBS=2;
+const char NNTYPSTR[]="fx2_";
+const char NTS[]="X2";
+#endif
+#ifdef _FIXPOINT3
+const int32_t FIXPOINTLIMBS=3;
+const char NNTYPSTR[]="fx3_";
+const char NTS[]="X3";
+#endif
+
+typedef unsigned __int128 UINT128;
+
+// two's complement fixed point number with N fractional 64-bit limbs:
+// value = (int64_t)w[N] + w[N-1]*2^-64 + ... + w[0]*2^-64N.
+// Products are exact as long as the result needs at most 64*N
+// fractional bits (see check_bitprecision)
+// limb loops are unrolled, N is a compile-time constant
+template<int N> struct FixPoint {
+	uint64_t w[N+1];
+	
+	FixPoint() {
+		// uninitialized
+	}
+	
+	FixPoint(const int a) {
+		for(int32_t i=0;i<N;i++) w[i]=0;
+		w[N]=(uint64_t)(int64_t)a;
+	}
+	
+	FixPoint(const double a) {
+		for(int32_t i=0;i<=N;i++) w[i]=0;
+		if (a == 0.0) return;
+		
+		int e;
+		double m=frexp(fabs(a),&e);
+		// |a|=mi*2^(e-53)
+		uint64_t mi=(uint64_t)ldexp(m,53);
+		int32_t pos=e-53+64*N;
+		if (pos < 0) {
+			mi >>= (-pos);
+			pos=0;
+		}
+		int32_t limb=(pos >> 6);
+		int32_t sh=(pos & 63);
+		w[limb] |= (mi << sh);
+		if ( (sh > 0) && (limb < N) ) w[limb+1] |= (mi >> (64-sh));
+		if (a < 0.0) *this=-(*this);
+	}
+	
+	explicit operator double() const {
+		FixPoint b=*this;
+		double sign=1.0;
+		if (isNegative()) {
+			b=-b;
+			sign=-1.0;
+		}
+		double r=0.0;
+		for(int32_t i=0;i<=N;i++) r += ldexp( (double)b.w[i],64*(i-N) );
+		
+		return sign*r;
+	}
+	
+	inline bool isNegative(void) const {
+		return ( (int64_t)w[N] < 0 );
+	}
+	
+	friend inline FixPoint operator-(const FixPoint& a) {
+		FixPoint r;
+		UINT128 c=1;
+		#pragma GCC unroll 4
+		for(int32_t i=0;i<=N;i++) {
+			c += (UINT128)(~a.w[i]);
+			r.w[i]=(uint64_t)c;
+			c >>= 64;
+		}
+		
+		return r;
+	}
+	
+	friend inline FixPoint operator+(const FixPoint& a,const FixPoint& b) {
+		FixPoint r;
+		UINT128 c=0;
+		#pragma GCC unroll 4
+		for(int32_t i=0;i<=N;i++) {
+			c += (UINT128)a.w[i] + b.w[i];
+			r.w[i]=(uint64_t)c;
+			c >>= 64;
+		}
+		
+		return r;
+	}
+	
+	friend inline FixPoint operator-(const FixPoint& a,const FixPoint& b) {
+		FixPoint r;
+		UINT128 c=1;
+		#pragma GCC unroll 4
+		for(int32_t i=0;i<=N;i++) {
+			c += (UINT128)a.w[i] + (UINT128)(~b.w[i]);
+			r.w[i]=(uint64_t)c;
+			c >>= 64;
+		}
+		
+		return r;
+	}
+	
+	// schoolbook product, 64x64->128 bit per limb pair, of the limbs read
+	// as unsigned numbers. A negative factor then counts the other one
+	// 2^(64N+64) times too often, that is subtracted from the upper limbs.
+	// The lowest N limbs are dropped, they are zero for exact results
+	friend inline FixPoint operator*(const FixPoint& a,const FixPoint& b) {
+		uint64_t p[2*N+2];
+		
+		UINT128 c=0;
+		#pragma GCC unroll 4
+		for(int32_t k=0;k<=N;k++) {
+			c += (UINT128)a.w[0]*b.w[k];
+			p[k]=(uint64_t)c;
+			c >>= 64;
+		}
+		p[N+1]=(uint64_t)c;
+		#pragma GCC unroll 4
+		for(int32_t i=1;i<=N;i++) {
+			c=0;
+			#pragma GCC unroll 4
+			for(int32_t k=0;k<=N;k++) {
+				c += (UINT128)a.w[i]*b.w[k] + p[i+k];
+				p[i+k]=(uint64_t)c;
+				c >>= 64;
+			}
+			p[i+N+1]=(uint64_t)c;
+		}
+		
+		FixPoint r;
+		#pragma GCC unroll 4
+		for(int32_t i=0;i<=N;i++) r.w[i]=p[i+N];
+		if (a.isNegative()) {
+			c=1;
+			#pragma GCC unroll 4
+			for(int32_t i=1;i<=N;i++) {
+				c += (UINT128)r.w[i] + (UINT128)(~b.w[i-1]);
+				r.w[i]=(uint64_t)c;
+				c >>= 64;
+			}
+		}
+		if (b.isNegative()) {
+			c=1;
+			#pragma GCC unroll 4
+			for(int32_t i=1;i<=N;i++) {
+				c += (UINT128)r.w[i] + (UINT128)(~a.w[i-1]);
+				r.w[i]=(uint64_t)c;
+				c >>= 64;
+			}
+		}
+		
+		return r;
+	}
+	
+	friend inline FixPoint operator*(const int a,const FixPoint& b) {
+		return FixPoint(a)*b;
+	}
+	
+	friend inline bool operator<(const FixPoint& a,const FixPoint& b) {
+		if (a.w[N] != b.w[N]) return ( (int64_t)a.w[N] < (int64_t)b.w[N] );
+		for(int32_t i=N-1;i>=0;i--) {
+			if (a.w[i] != b.w[i]) return (a.w[i] < b.w[i]);
+		}
+		
+		return false;
+	}
+	
+	friend inline bool operator>(const FixPoint& a,const FixPoint& b) {
+		return (b < a);
+	}
+	
+	friend inline bool operator<=(const FixPoint& a,const FixPoint& b) {
+		return !(b < a);
+	}
+	
+	friend inline bool operator>=(const FixPoint& a,const FixPoint& b) {
+		return !(a < b);
+	}
+	
+	friend inline bool operator==(const FixPoint& a,const FixPoint& b) {
+		for(int32_t i=0;i<=N;i++) {
+			if (a.w[i] != b.w[i]) return false;
+		}
+		
+		return true;
+	}
+	
+	friend inline bool operator!=(const FixPoint& a,const FixPoint& b) {
+		return !(a == b);
+	}
+};
+
+typedef FixPoint<FIXPOINTLIMBS> NTYP;
+
+inline void minimaxFXAB(NTYP& mi,NTYP& ma,const NTYP& a,const NTYP& b) {
+	if (a < b) {
+		mi=a; ma=b;
+	} else {
+		mi=b; ma=a;
+	}
+}
+
+inline void minimaxFXABCD(NTYP& mi,NTYP& ma,
+	const NTYP& a,const NTYP& b,
+	const NTYP& c,const NTYP& d
+) {
+	const NTYP *miab,*maab,*micd,*macd;
+	if (a < b) {
+		miab=&a; maab=&b;
+	} else {
+		miab=&b; maab=&a;
+	}
+	if (c < d) {
+		micd=&c; macd=&d;
+	} else {
+		micd=&d; macd=&c;
+	}
+	
+	if ((*miab) < (*micd)) mi=*miab; else mi=*micd;
+	if ((*maab) > (*macd)) ma=*maab; else ma=*macd;
+}
+
+// the integer limb is the floor
+inline int64_t floorFX(const NTYP& a) {
+	return (int64_t)a.w[FIXPOINTLIMBS];
+}
+#endif
+
 #ifdef _FPA
 struct FPA {
 	// UVLONG or DDBYTE not performance-relevant
@@ -258,7 +559,37 @@ const uint32_t power2[]={
 enum { 
 	CMD_CALC=1,
 	CMD_PERIOD,
-	CMD_FASTDTCHECK
+	CMD_FASTDTCHECK,
+	CMD_CONVERT,
+	CMD_SWEEP,
+	CMD_LAYOUTBENCH,
+	CMD_VERIFY,
+	CMD_CBOX
+};
+
+// order in which propagate_definite visits the tiles
+enum {
+	ORDER_RASTER=0,
+	ORDER_ALTERNATE,
+	ORDER_HILBERT,
+	
+	ORDERANZ
+};
+
+const char ordername[][16] = {
+	"RASTER","ALTERNATE","HILBERT"
+};
+
+// how bounding boxes are enclosed
+enum {
+	BBX_IA=0,
+	BBX_CENTRED,
+	
+	BBXANZ
+};
+
+const char bbxname[][16] = {
+	"IA","CENTRED"
 };
 
 // not all are implemented, but values need be the same as
@@ -312,6 +643,15 @@ const uint32_t SQUARE_GRAY_16_CONSECUTIVE=CFALL(SQUARE_GRAY);
 const uint32_t SQUARE_GRAYPOTW_16_CONSECUTIVE=CFALL(SQUARE_GRAY_POTENTIALLY_WHITE);
 const uint32_t SQUARE_WHITE_16_CONSECUTIVE=CFALL(SQUARE_WHITE);
 const uint32_t SQUARE_BLACK_16_CONSECUTIVE=CFALL(SQUARE_BLACK);
+// low bit of every 2-bit pixel color in a 32bit integer
+const uint32_t LANES_LOWBIT=CFALL(0b01);
+
+// result of a rectangle scan: one flag per color found
+// indexed by the 2-bit color code
+const int32_t RECTSCAN_GRAY=(1 << SQUARE_GRAY);
+const int32_t RECTSCAN_WHITE=(1 << SQUARE_WHITE);
+const int32_t RECTSCAN_BLACK=(1 << SQUARE_BLACK);
+const int32_t RECTSCAN_GRAYPOTW=(1 << SQUARE_GRAY_POTENTIALLY_WHITE);
 const int32_t BASEDENOMINATOR=25;
 const int64_t DENOM225=( (int64_t)1 << BASEDENOMINATOR );
 #ifdef _CHUNK512
@@ -420,22 +760,6 @@ struct FatouComponent {
 	int8_t isimmediate; // flag
 };
 
-// one reverse cell graph tile and its parents (preimages before the iteration)
-struct RevCGBlock {
-	// how many parents are needed here? First pass result
-	int32_t howmany; 
-	// flag, whether this tile has to be checked (again) for gray pixels and the bounding
-	// boxes' hits after one iteration
-	int8_t tovisit;
-	int8_t containsgray;
-	int32_t memused;
-	// parents as variable size array
-	Parent* parent;
-		
-	RevCGBlock();
-	void addParent(const int32_t,const int32_t);
-};
-
 struct Int2Manager {
 	Int2* current;
 	int32_t allokierteIdx,freiAbIdx,allokierePerBlockIdx;
@@ -458,11 +782,76 @@ struct ScreenRectManager {
 	ScreenRect* getMemory(const int32_t);
 };
 
+// run of non-white 32bit integers mem0..mem1 of a row, stored at
+// zeilen[y][offset..offset+mem1-mem0]
+struct GraySpan {
+	int32_t mem0,mem1;
+	int32_t offset;
+	// the integers between the previous span and this one are
+	// black, not white (BLACKGAPS=1)
+	int8_t blackbefore;
+};
+
+typedef GraySpan *PGraySpan;
+
+struct GraySpanManager {
+	GraySpan* current;
+	int32_t allokierteIdx,freiAbIdx,allokierePerBlockIdx;
+	PGraySpan ptr[MAXPTR];
+	int32_t anzptr;
+	
+	GraySpanManager();
+	virtual ~GraySpanManager();
+	GraySpan* getMemory(const int32_t);
+};
+
 struct Gray_in_row {
+	// enclosement of all spans: pixels and 32bit integers
 	int32_t g0,g1;
 	int32_t mem0,mem1;
+	// spans sorted increasingly, integers in between are white
+	// or - if the later span says so - black
+	int32_t anzspans,spanmemused;
+	GraySpan* spans;
+	// an integer was set to white (or black, if black gaps are
+	// used) since the row was last tightened
+	int8_t settled;
+	
+	void setEmpty(void);
+	void setEnclosement(void);
+	int32_t words(void);
+	int32_t firstSpan(const int32_t) const;
+	int8_t overlaps(const int32_t,const int32_t);
 };
 
+// white or black gaps of at least that many 32bit integers split a span
+const int32_t GRAYSPAN_MINGAP=4;
+
+// position of integer amem in the row's memory, -1 if it lies
+// in a gap
+static inline int32_t grayword_offset(const Gray_in_row& ar,const int32_t amem) {
+	if ( (amem < ar.mem0) || (amem > ar.mem1) ) return -1;
+	
+	int32_t left=0,right=ar.anzspans-1;
+	while (left < right) {
+		int32_t m=(left+right+1) >> 1;
+		if (ar.spans[m].mem0 <= amem) left=m; else right=m-1;
+	}
+	
+	if (amem > ar.spans[left].mem1) return -1;
+	
+	return ar.spans[left].offset + (amem - ar.spans[left].mem0);
+}
+
+// the 16 pixels of integer amem lying in a gap
+static inline DDBYTE gapword(const Gray_in_row& ar,const int32_t amem) {
+	if ( (amem < ar.mem0) || (amem > ar.mem1) ) return SQUARE_WHITE_16_CONSECUTIVE;
+	
+	if (ar.spans[ar.firstSpan(amem)].blackbefore > 0) return SQUARE_BLACK_16_CONSECUTIVE;
+	
+	return SQUARE_WHITE_16_CONSECUTIVE;
+}
+
 struct ColorPalette {
 	int32_t anz;
 	RGB4* rgbs;
@@ -514,25 +903,94 @@ struct ArrayDDByteManager {
 	int allokierteIdx,freiAbIdx,allokierePerBlockIdx;
 	PDDBYTE ptr[MAXPTR];
 	int anzptr;
+	int reuseidx; // chunks below anzptr handed out again after rewind
 	
 	ArrayDDByteManager ();
 	virtual ~ArrayDDByteManager ();
 	PDDBYTE getMemory(const int32_t);
+	void rewind(void);
+	int32_t chunkOf(const DDBYTE*);
+	int64_t releaseAfter(const int32_t,const int32_t);
 };
 
-struct VGridRow {
-	int32_t x0,x1; // offset
-	BYTE *shrinkptr;
+const int32_t MAXSUMMARYCYCLES=16;
+
+// virtual grid cost model: every VGRIDSAMPLESTEP-th gray pixel of a row
+// is sampled, scanning VGRIDWORDSPERBBX 32-bit integers of a target
+// rectangle costs about as much as one bounding box
+const int32_t VGRIDSAMPLESTEP=16;
+const int32_t VGRIDWORDSPERBBX=16;
+const double VGRIDDEFAULTCHECKS=4.0;
+
+// window mode: at most that many tiles per row and column
+const int32_t WINDOWMAXTILES=2048;
+
+// compact result of one job (JuliaEngine, cmd=sweep)
+struct JobSummary {
+	int8_t interior;
+	int64_t gray; // gray and potentially white pixels
+	int32_t anzcycles; // < 0: periodicity not checked
+	int32_t cyclelen[MAXSUMMARYCYCLES];
+	int32_t level;
+	int64_t bbx; // bounding boxes calculated
+	double sec;
+};
+
+// precision analysis: the real or imaginary part of a function value
+// as polynomial in the tile coordinates x,y, seed c=d+e*i and
+// factor A=f+g*i
+enum {
+	BITVAR_X=0,BITVAR_Y,BITVAR_D,BITVAR_E,BITVAR_F,BITVAR_G,
+	
+	BITVAR_ANZ
+};
+
+const int32_t MAXMONOMIALS=64;
+
+struct Monomial {
+	int64_t factor;
+	int8_t exponent[BITVAR_ANZ];
+};
+
+struct BitPoly {
+	Monomial m[MAXMONOMIALS];
+	int32_t anz;
+	
+	void setNull(void);
+	void setVar(const int32_t);
+	void addMonomial(const Monomial&);
+	void add(const BitPoly&,const int32_t);
+	void mul(const BitPoly&,const BitPoly&);
+};
+
+struct BitComplex {
+	BitPoly re,im;
+	
+	void add(const BitComplex&);
+	void mul(const BitComplex&,const BitComplex&);
 };
 
 // main object
 struct Data5 {
 	uint32_t** zeilen;
 	Gray_in_row* memgrau;
+	GraySpanManager* spanmgr;
+	DDBYTE* rowbuffer;
+	GraySpan* spanbuffer;
 	uint8_t* graudensity;
-	RevCGBlock* revcgYX;
+	// reverse cell graph in compressed sparse row form: the parents of
+	// tile (BX,BY) are revcgparents[BY][revcgoffset[BY*(N+1)+BX] .. [..+BX+1]-1]
+	// with N=REVCGmaxnumber, offsets are relative to the tile row
+	uint32_t* revcgoffset;
+	PParent* revcgparents;
+	// one bit per tile: has to be checked (again) for gray pixels
+	// and the bounding boxes' hits after one iteration
+	uint64_t* revcgtovisit;
+	uint64_t* revcgcontainsgray;
+	// screen rectangle of the bounding box image of every tile
+	// that can be a parent, in pixels
+	ScreenRect* revcgimage;
 	ArrayDDByteManager* datamgr;
-	VGridRow *vgridYX;
 	PScreenRect *pcscr;
 	ScreenRectManager *pcscrmgr;
 		
@@ -542,8 +1000,23 @@ struct Data5 {
 	void saveBitmap4_twd(const char*,const int32_t);
 	void saveRaw(const char*);
 	int32_t readRawBlowUp(void);
-	
+	int32_t refineFrom(Data5*);
+	int32_t setupWindow(void);
+	void foldSymmetric(void);
+	void unfoldSymmetric(void);
+	void storeBlackGaps(void);
+	int64_t setRowPairBlowUp(const int32_t,DDBYTE*,const int32_t,const int32_t);
+	void setRowPairEmpty(const int32_t);
+	int64_t setRowWords(const int32_t,const DDBYTE*,const int32_t,const int32_t);
+	int64_t setRowCopy(const int32_t,const int32_t);
+	int32_t getRowWords(const int32_t,DDBYTE*,int32_t&);
+	void setRowFull(const int32_t);
+	void tightenRow(const int32_t);
+	void tightenRows(const int8_t);
+	int64_t compactMemory(void);
+
 	void precomputeScreenRect(void);
+	int8_t vgridRowPays(const int32_t,const NTYP&);
 };
 
 struct RefPoint {
@@ -619,11 +1092,132 @@ struct ParentManager {
 	int32_t freefrom;
 	int32_t anzptr;
 	PParent ptr[MAXPTR];
+	int32_t reuseidx;
 	
 	ParentManager();
 	virtual ~ParentManager();
 	
 	Parent* getParentSpace(const int32_t);
+	void rewind(void);
+};
+
+// yields the tiles of tile rows row0..row1 that are to be visited
+// and contain gray, in the order set by ORDER=
+struct RevCGOrder {
+	int32_t order;
+	int8_t backward;
+	int32_t row0,row1;
+	int64_t from,end;
+	int64_t cursor;
+	
+	void start(const int32_t,const int32_t,const int32_t,const int32_t);
+	int64_t next(void);
+};
+
+// gray pixel and the screen rectangle its bounding box hits
+struct PotwSource {
+	int32_t x,y;
+	ScreenRect scr;
+};
+
+// propagating potentially white as a reverse search: the first sweep
+// stores every pixel that stays gray with its image rectangle and marks
+// the tiles where pixels changed. Sources are indexed by the reverse cell
+// graph tiles their rectangle covers, and only sources covering a changed
+// tile are checked again - without a new bounding box
+struct PotwBFS {
+	int64_t capacity,maxbytes;
+	PotwSource* sources;
+	int64_t anzsources;
+	// CSR: sources covering tile T are
+	// tilesources[tileoffset[T] .. tileoffset[T+1]-1]
+	uint32_t* tileoffset;
+	uint32_t* tilesources;
+	// tiles with pixels changed since they were last checked
+	uint64_t* tilechanged;
+	int64_t reached;
+	
+	PotwBFS();
+	virtual ~PotwBFS();
+	int8_t init(const int64_t);
+	void addSource(const int32_t,const int32_t,const ScreenRect&);
+	void addChanged(const int32_t,const int32_t);
+	int8_t buildGraph(void);
+	void run(void);
+	void checkTile(const int64_t);
+};
+
+// coarse global image (ORACLE=) giving the colors outside the window
+// (WINDOW=): a coarse white or black pixel is the color of all its
+// sub-pixels, coarse gray counts as potentially white
+struct WindowOracle {
+	int32_t width,shift;
+	// coarse row y: rowlen[y] integers from integer rowstart[y] on,
+	// stored at words[rowoffset[y]..], the rest of the row is white
+	int32_t *rowstart,*rowlen;
+	int64_t *rowoffset;
+	DDBYTE* words;
+	// window in pixels of the current level, multiples of 16 and
+	// of the coarse pixel width
+	int32_t x0,x1,y0,y1;
+	// non-white part of the coarse image in coarse pixels
+	int32_t cx0,cx1,cy0,cy1;
+
+	WindowOracle();
+	virtual ~WindowOracle();
+	int8_t read(const char*,const int32_t);
+	void setWindow(const double,const double,const double,const double);
+	int32_t colorAt(const int32_t,const int32_t);
+	int32_t scanCoarse(const ScreenRect&,const int32_t,const int32_t,int32_t);
+	int32_t scanOutside(const ScreenRect&,const int32_t,const int32_t,ScreenRect&);
+};
+
+// set associative cache with LRU replacement, counts the misses of
+// a stream of 64 byte line addresses (cmd=layoutbench)
+struct CacheLevel {
+	int32_t anzsets,ways;
+	// per set the line addresses, most recently used first
+	uint64_t* tags;
+	int64_t accesses,misses;
+	
+	CacheLevel(const int32_t,const int32_t);
+	virtual ~CacheLevel();
+	int8_t access(const uint64_t);
+};
+
+// L1 backed by L2, memory is read in 64 byte lines
+struct CacheModel {
+	CacheLevel *l1,*l2;
+	uint64_t lastline;
+	
+	CacheModel();
+	virtual ~CacheModel();
+	void touch(const void*);
+};
+
+// 64x64 pixel bricks for cmd=layoutbench: a brick holds 64 rows of
+// 4 32bit integers. Only bricks with non-white pixels are stored,
+// sorted by the Morton key of their position and found by binary
+// search. Completely black bricks hold no integers
+const int32_t BRICKBITS=6;
+const int32_t BRICKWORDS=(1 << BRICKBITS)*( (1 << BRICKBITS) >> 4);
+
+struct BrickImage {
+	int64_t anzbricks;
+	uint64_t* keys;
+	// -1 for completely black bricks
+	int64_t* offset;
+	DDBYTE* words;
+	int64_t anzwords;
+	
+	BrickImage();
+	virtual ~BrickImage();
+	void build(void);
+	int64_t find(const int32_t,const int32_t,CacheModel*);
+	int32_t colorAt(const int32_t,const int32_t);
+	int32_t scanRect(const ScreenRect&,const int32_t,const int32_t);
+	void touchRect(const ScreenRect&,CacheModel&);
+	int64_t memory(void);
 };
 
 const int32_t MAXHELPERVALUES=32;
@@ -653,10 +1247,12 @@ struct HelperManager {
 	int32_t allokierteIdx,freiAbIdx,allokierePerBlockIdx;
 	PHelper ptr[MAXPTR];
 	int32_t anzptr;
+	int32_t reuseidx;
 	
 	HelperManager();
 	virtual ~HelperManager();
 	PHelper getMemory(const int32_t);
+	void rewind(void);
 };
 
 struct Helper_doubleManager {
@@ -977,87 +1573,176 @@ enum {
 };
 
 
+// thrown by fatal_exit inside JuliaEngine::run
+struct EngineError {
+	int32_t code;
+};
+
+const int32_t MAXENGINEPARAMS=64;
+const int32_t MAXENGINEPARAMLEN=256;
+
+// one computation unit: parameters in command line syntax and the
+// arenas (image rows, parents, helpers) that stay allocated between
+// its jobs. All engine state is bound to the globals while run()
+// executes, errors are reported as return value instead of ending
+// the process.
+// Engines can be used one after another in one process, with
+// _MULTIENGINE also concurrently on different threads.
+struct JuliaEngine {
+	char param[MAXENGINEPARAMS][MAXENGINEPARAMLEN];
+	int32_t anzparam;
+	int8_t freshstart; // never read _in.raw
+	char tempfn[64]; // principal part of intermediate saves
+	char infn[1024]; // stored data read instead of _in.raw
+	char rawfn[1024]; // raw data saved by the last job, empty if none
+	JobSummary summary;
+	// kept warm between jobs
+	ParentManager* keptparentmgr;
+	HelperManager* kepthelpermgr;
+	ArrayDDByteManager* keptdatamgr;
+	
+	JuliaEngine();
+	virtual ~JuliaEngine();
+	
+	void clearParameters(void);
+	int32_t addParameter(const char*);
+	int32_t run(void);
+	void bind(void);
+	void unbind(void);
+};
+
 // globals
 
-int8_t SAVEIMAGE=1;
-int64_t ctrbbxfa=0;
-int8_t _RESETPOTW=0;
-int8_t _PRECOMPUTEBBXMEMORYGB=0;
-ByteManager vgridmgr;
-int32_t _SHRINKAGEUSABLE=0;
-int32_t _VIRTUALGRIDBITS=0;
-int64_t _VIRTUALGRIDMEMORY=0;
+ENGINELOCAL int8_t SAVEIMAGE=1;
+ENGINELOCAL int64_t ctrbbxfa=0;
+ENGINELOCAL int8_t _RESETPOTW=0;
+ENGINELOCAL int8_t _PRECOMPUTEBBXMEMORYGB=0;
+ENGINELOCAL int32_t _POTWBFSMEMORYGB=1;
+ENGINELOCAL int32_t _ORDER=ORDER_RASTER;
+ENGINELOCAL int32_t _BBXMETHOD=BBX_IA;
+// centred form for f(z)=z^d+A*z+c, 0=not used
+ENGINELOCAL int32_t _CENTREDDEGREE=0;
+ENGINELOCAL int8_t _CENTREDUSEA=0;
+// summed bounding box areas before and after the centred form
+ENGINELOCAL double centredareaia=0.0,centredarea=0.0;
+// virtual grid: precomputed pixels are split into 2^bits x 2^bits
+// subsquares, their union is stored if it saves at least
+// _SHRINKAGEUSABLE pixel rows and columns
+ENGINELOCAL int32_t _VIRTUALGRIDBITS=0;
+ENGINELOCAL int32_t _SHRINKAGEUSABLE=1;
+// cost model: checks per gray pixel and level as the last level had them
+ENGINELOCAL double vgridchecks=0.0;
+ENGINELOCAL int64_t ctrpcscrchecks=0;
+// runs of black 32bit integers are not stored but are gaps between
+// spans like white ones
+ENGINELOCAL int8_t _BLACKGAPS=1;
+// WINDOW=re0,re1,im0,im1: only the window is refined, the rest of the
+// plane is read from the image at level ORACLE=
+ENGINELOCAL int8_t _WINDOW=0;
+ENGINELOCAL double windowre0,windowre1,windowim0,windowim1;
+ENGINELOCAL int32_t _ORACLELEVEL=0;
+ENGINELOCAL WindowOracle* windoworacle=NULL;
+// squared escape radius of the function, rounded up: every point
+// outside that disk escapes. 0 if not known or ESCAPEDISK=0
+ENGINELOCAL double escaperadius2=0.0;
+ENGINELOCAL int8_t _ESCAPEDISK=1;
+// cmd=verify checks the block rows k, k+n, ... (VERIFYSLICE=k,n)
+ENGINELOCAL int32_t _VERIFYSLICE=0,_VERIFYSLICES=1;
 // pointer variables need be always declared
-HelperAccess *helperYdep=NULL;
-HelperAccess *helperXdep=NULL;
-HelperAccess_double *helperYdep_double=NULL;
-HelperAccess_double *helperXdep_double=NULL;
-HelperManager *helpermgr;
-Helper_doubleManager *helper_doublemgr;
-int8_t interiorpresent=0;
-int64_t checkclockatbbxcount0=10000000;
-int64_t checkclockatbbxadd=(1 << 26);
-int8_t _PERIODICITYMETHOD=1;
-int32_t CLOCKHOURSTOSAVE=CLOCKS_PER_SEC*3600*2;
-int8_t _PERIODICPOINTS=0;
-int8_t _PROPAGATEDEF=1;
-int8_t _PROPAGATEPOTW=1;
+ENGINELOCAL HelperAccess *helperYdep=NULL;
+ENGINELOCAL HelperAccess *helperXdep=NULL;
+ENGINELOCAL HelperAccess_double *helperYdep_double=NULL;
+ENGINELOCAL HelperAccess_double *helperXdep_double=NULL;
+ENGINELOCAL HelperManager *helpermgr;
+ENGINELOCAL Helper_doubleManager *helper_doublemgr;
+ENGINELOCAL int8_t interiorpresent=0;
+ENGINELOCAL int64_t checkclockatbbxcount0=10000000;
+ENGINELOCAL int64_t checkclockatbbxadd=(1 << 26);
+ENGINELOCAL int8_t _PERIODICITYMETHOD=1;
+ENGINELOCAL int32_t CLOCKHOURSTOSAVE=CLOCKS_PER_SEC*3600*2;
+ENGINELOCAL int8_t _PERIODICPOINTS=0;
+ENGINELOCAL int8_t _PROPAGATEDEF=1;
+ENGINELOCAL int8_t _PROPAGATEPOTW=1;
+// LEVELS=from..to: refinement ladder in one process
+ENGINELOCAL int32_t LEVELFROM=0,LEVELTO=0;
+ENGINELOCAL int8_t _LEVELCHECKPOINT=0;
+// mirror symmetry along the real axis: rows y and SCREENWIDTH-1-y share
+// their memory and only the lower half is propagated
+ENGINELOCAL int8_t _SYMMETRY=0;
+ENGINELOCAL int8_t _USESYMMETRY=0;
+// JuliaEngine::freshstart, e.g. sweep jobs: _in.raw is never read
+ENGINELOCAL int8_t _FRESHSTART=0;
+// engine whose state the globals currently hold
+ENGINELOCAL JuliaEngine* activeengine=NULL;
+ENGINELOCAL char TEMPFN[64]="_temp";
+ENGINELOCAL char INFN[1024]="_in.raw";
+ENGINELOCAL char SAVEDRAWFN[1024];
+ENGINELOCAL JobSummary jobsummary;
+ENGINELOCAL ArrayDDByteManager *sparedatamgr=NULL;
+// shared by all engines
 FILE *flog=NULL;
-Cycle* cycles=NULL;
-FatouComponent* ibfcomponents=NULL;
-int32_t anzibf=0;
-int32_t anzcycles=0;
-ColorPalette basinpal;
-void (*getBoundingBoxfA)(PlaneRect&,PlaneRect&) = NULL;
-void (*getBoundingBoxfA_double)(PlaneRect_double&,PlaneRect_double&,Helper_double*,Helper_double*) = NULL;
-void (*getBoundingBoxfA_double_oh)(PlaneRect_double&,PlaneRect_double&) = NULL;
-void (*getBoundingBoxfA_helper)(PlaneRect&,PlaneRect&,Helper*,Helper*) = NULL;
-void (*precompute_helperYdep)(PlaneRect&,Helper*) = NULL;
-void (*precompute_helperXdep)(PlaneRect&,Helper*) = NULL;
-void (*precompute_helperYdep_double)(PlaneRect_double&,Helper_double*) = NULL;
-void (*precompute_helperXdep_double)(PlaneRect_double&,Helper_double*) = NULL;
-int32_t _FUNC;
-ParentManager* parentmgr=NULL;
-int32_t REFINEMENTLEVEL=0;
-NTYP seedC0re,seedC1re,seedC0im,seedC1im; 
-NTYP FAKTORAre,FAKTORAim;
-Data5 *data5;
-NTYP scaleRangePerPixel,scalePixelPerRange;
-
-double seedC0re_double,seedC1re_double,seedC0im_double,seedC1im_double; 
-double FAKTORAre_double,FAKTORAim_double;
-double FAKTORBre_double,FAKTORBim_double;
-double scaleRangePerPixel_double,scalePixelPerRange_double;
-
-int32_t scalePixelPerRangeExponent=0;
-int64_t countsquares_white,countsquares_gray;
-int64_t countsquares_black,countsquares_graypotw;
+ENGINELOCAL Cycle* cycles=NULL;
+ENGINELOCAL FatouComponent* ibfcomponents=NULL;
+ENGINELOCAL int32_t anzibf=0;
+ENGINELOCAL int32_t anzcycles=0;
+ENGINELOCAL ColorPalette basinpal;
+ENGINELOCAL void (*getBoundingBoxfA)(PlaneRect&,PlaneRect&) = NULL;
+ENGINELOCAL void (*getBoundingBoxfA_double)(PlaneRect_double&,PlaneRect_double&,Helper_double*,Helper_double*) = NULL;
+ENGINELOCAL void (*getBoundingBoxfA_double_oh)(PlaneRect_double&,PlaneRect_double&) = NULL;
+ENGINELOCAL void (*getBoundingBoxfA_helper)(PlaneRect&,PlaneRect&,Helper*,Helper*) = NULL;
+// interval extensions (always set): the centred form refines them,
+// tile boxes of the reverse cell graph need their isotonicity
+ENGINELOCAL void (*getBoundingBoxfA_ia)(PlaneRect&,PlaneRect&) = NULL;
+ENGINELOCAL void (*getBoundingBoxfA_helper_ia)(PlaneRect&,PlaneRect&,Helper*,Helper*) = NULL;
+ENGINELOCAL void (*precompute_helperYdep)(PlaneRect&,Helper*) = NULL;
+ENGINELOCAL void (*precompute_helperXdep)(PlaneRect&,Helper*) = NULL;
+ENGINELOCAL void (*precompute_helperYdep_double)(PlaneRect_double&,Helper_double*) = NULL;
+ENGINELOCAL void (*precompute_helperXdep_double)(PlaneRect_double&,Helper_double*) = NULL;
+ENGINELOCAL int32_t _FUNC;
+ENGINELOCAL ParentManager* parentmgr=NULL;
+ENGINELOCAL int32_t REFINEMENTLEVEL=0;
+ENGINELOCAL NTYP seedC0re,seedC1re,seedC0im,seedC1im; 
+ENGINELOCAL NTYP FAKTORAre,FAKTORAim;
+ENGINELOCAL Data5 *data5;
+ENGINELOCAL NTYP scaleRangePerPixel,scalePixelPerRange;
+
+ENGINELOCAL double seedC0re_double,seedC1re_double,seedC0im_double,seedC1im_double; 
+ENGINELOCAL double FAKTORAre_double,FAKTORAim_double;
+ENGINELOCAL double FAKTORBre_double,FAKTORBim_double;
+ENGINELOCAL double scaleRangePerPixel_double,scalePixelPerRange_double;
+
+ENGINELOCAL int32_t scalePixelPerRangeExponent=0;
+ENGINELOCAL int64_t countsquares_white,countsquares_gray;
+ENGINELOCAL int64_t countsquares_black,countsquares_graypotw;
 // region in the complex plane where all the currently still gray squares reside
-NTYP planegrayx0,planegrayx1;
-NTYP planegrayy0,planegrayy1;
+ENGINELOCAL NTYP planegrayx0,planegrayx1;
+ENGINELOCAL NTYP planegrayy0,planegrayy1;
 // region in screen coordinates
-int32_t encgrayx0,encgrayx1;
-int32_t encgrayy0,encgrayy1;
+ENGINELOCAL int32_t encgrayx0,encgrayx1;
+ENGINELOCAL int32_t encgrayy0,encgrayy1;
 // width of screen in pixel, must be a power of 2
-int32_t SCREENWIDTH;
-double RANGE0=-2,RANGE1=2; // no longer int, as ranges 0.5 etc shall be possible
-NTYP COMPLETE0,COMPLETE1;
-double COMPLETE0_double,COMPLETE1_double;
+ENGINELOCAL int32_t SCREENWIDTH;
+ENGINELOCAL double RANGE0=-2,RANGE1=2; // no longer int, as ranges 0.5 etc shall be possible
+ENGINELOCAL NTYP COMPLETE0,COMPLETE1;
+ENGINELOCAL double COMPLETE0_double,COMPLETE1_double;
 // for the low-resolution reverse cell graph working on (usually) 64x64 pixel squares or bigger
-int32_t REVCGBITS,REVCGBLOCKWIDTH;
-int32_t REVCGmaxnumber,REVCGmaxnumberQ;
+ENGINELOCAL int32_t REVCGBITS,REVCGBLOCKWIDTH;
+ENGINELOCAL int32_t REVCGmaxnumber,REVCGmaxnumberQ;
 // variables for bit precision checks
 
 
 // forward declarations
 
 void compute(void);
+[[noreturn]] void fatal_exit(const int32_t);
+void free_job_memory(void);
 void freeRevCGMem(void);
 void construct_static_reverse_cellgraph(void);
 void find_special_exterior_hitting_squares(void);
 void propagate_definite(void);
 void propagate_potw(void);
-int32_t color_changeS32(const DDBYTE,const DDBYTE,const DDBYTE,const DDBYTE);
+int32_t color_changeS32(const DDBYTE,const DDBYTE);
+static int32_t scan_rect_colors(const ScreenRect&,const int32_t,const int32_t);
 void copy_pixel_to_2x2grid(const uint32_t,uint32_t*);
 
 static inline int32_t scrcoord_as_lowerleft(const NTYP&);
@@ -1163,15 +1848,20 @@ inline double maximumdouble(const double,const double,const double,const double)
 	}\
 }
 
+#define SETDATA5BYOFFSET(OFF,YY,WW32) \
+{\
+	data5->zeilen[YY][OFF]=WW32;\
+	if ( (WW32) == SQUARE_WHITE_16_CONSECUTIVE ) data5->memgrau[YY].settled=1;\
+	else if ( ( (WW32) == SQUARE_BLACK_16_CONSECUTIVE ) && (_BLACKGAPS>0) ) data5->memgrau[YY].settled=1;\
+}
+
 #define SETDATA5BYMEM_MY(MM,YY,WW32) \
 {\
-	if ( \
-		((MM) >= data5->memgrau[YY].mem0) &&\
-		((MM) <= data5->memgrau[YY].mem1)\
-	) {\
-		data5->zeilen[YY][MM - data5->memgrau[YY].mem0]=WW32;\
+	const int32_t woffset=grayword_offset(data5->memgrau[YY],MM);\
+	if (woffset >= 0) {\
+		SETDATA5BYOFFSET(woffset,YY,WW32)\
 	} else {\
-		if ( (WW32) != SQUARE_WHITE_16_CONSECUTIVE ) { \
+		if ( (WW32) != gapword(data5->memgrau[YY],MM) ) { \
 			LOGMSG4("Implementation Error. SET MM=%i YY=%i WW=%i\n",MM,YY,WW32);\
 		}\
 	}\
@@ -1179,13 +1869,11 @@ inline double maximumdouble(const double,const double,const double,const double)
 
 #define GETDATA5BYMEM_MY(MM,YY,ERG) \
 {\
-	if ( \
-		((MM) >= data5->memgrau[YY].mem0) &&\
-		((MM) <= data5->memgrau[YY].mem1)\
-	) {\
-		ERG=data5->zeilen[YY][MM - data5->memgrau[YY].mem0];\
+	const int32_t woffset=grayword_offset(data5->memgrau[YY],MM);\
+	if (woffset >= 0) {\
+		ERG=data5->zeilen[YY][woffset];\
 	} else {\
-		ERG=SQUARE_WHITE_16_CONSECUTIVE;\
+		ERG=gapword(data5->memgrau[YY],MM);\
 	}\
 }
 
@@ -1195,34 +1883,67 @@ inline double maximumdouble(const double,const double,const double,const double)
 	printf(TT);\
 }
 
+// pcscr[y] is laid out like the row's memory, 16 entries per 32bit integer:
+// pixel x of the integer at position OFF is entry (OFF << 4) + (x & 15)
 #define SETPCSCR(XX,YY,WX0,WX1,WY0,WY1) \
 {\
-	const int32_t xpos=(XX)-data5->memgrau[YY].g0;\
+	const int32_t xpos=(grayword_offset(data5->memgrau[YY],(XX) >> 4) << 4) + ((XX) & 0b1111);\
 	data5->pcscr[YY][xpos].x0=WX0;\
 	data5->pcscr[YY][xpos].x1=WX1;\
 	data5->pcscr[YY][xpos].y0=WY0;\
 	data5->pcscr[YY][xpos].y1=WY1;\
 }
 
-#define GETPCSCR(XX,YY,SCR) \
+#define GETPCSCR(POS,YY,SCR) \
 {\
-	const int32_t xpos=(XX)-data5->memgrau[YY].g0;\
+	const int32_t xpos=(POS);\
+	ctrpcscrchecks++;\
 	SCR.x0=data5->pcscr[YY][xpos].x0;\
 	SCR.x1=data5->pcscr[YY][xpos].x1;\
 	if (SCR.x1 == -2) {\
-		LOGMSG3("Error/getpcscr %i,%i\n",XX,YY);\
-		exit(99);\
+		LOGMSG3("Error/getpcscr %i,%i\n",xpos,YY);\
+		fatal_exit(99);\
 	}\
 	SCR.y0=data5->pcscr[YY][xpos].y0;\
 	SCR.y1=data5->pcscr[YY][xpos].y1;\
 }
 
+#define REVCGSETBIT(BS,IDX) \
+{\
+	(BS)[(IDX) >> 6] |= ((uint64_t)1 << ((IDX) & 63));\
+}
+
+#define REVCGCLEARBIT(BS,IDX) \
+{\
+	(BS)[(IDX) >> 6] &= ~((uint64_t)1 << ((IDX) & 63));\
+}
+
+#define REVCGGETBIT(BS,IDX) \
+	( ( (BS)[(IDX) >> 6] >> ((IDX) & 63) ) & 1 )
+
 #define SETTOVISIT(XX,YY) \
 {\
-	data5->revcgYX[\
-		(YY)*REVCGmaxnumber+\
-		(XX)\
-	].tovisit=1;\
+	int64_t visitidx=(int64_t)(YY)*REVCGmaxnumber+(XX);\
+	REVCGSETBIT(data5->revcgtovisit,visitidx)\
+}
+
+// marks those parents of tile (TX,TY) as to be visited whose
+// image intersects the changed pixels X0..X1 x Y0..Y1
+#define SETPARENTSTOVISIT(TX,TY,X0,X1,Y0,Y1) \
+{\
+	const uint32_t* tileoff=&data5->revcgoffset[(int64_t)(TY)*(REVCGmaxnumber+1)+(TX)];\
+	const Parent* tilepar=data5->revcgparents[TY];\
+	for(uint32_t pi=tileoff[0];pi<tileoff[1];pi++) {\
+		const ScreenRect* img=&data5->revcgimage[\
+			(int64_t)tilepar[pi].BY*REVCGmaxnumber+tilepar[pi].BX\
+		];\
+		if (\
+			(img->x0 <= (X1)) && (img->x1 >= (X0)) &&\
+			(img->y0 <= (Y1)) && (img->y1 >= (Y0))\
+		) {\
+			SETTOVISIT(tilepar[pi].BX,tilepar[pi].BY)\
+		}\
+	}\
 }
 
 #define LOGMSG2(TT,AA) \
@@ -1255,12 +1976,52 @@ inline double maximumdouble(const double,const double,const double,const double)
 	printf(TT,AA,BB,CC,DD,EE);\
 }
 
+// distance of the interval a0..a1 to 0
+static inline double interval_distance0(const double a0,const double a1) {
+	if (a0 > 0.0) return a0;
+	if (a1 < 0.0) return -a1;
+	
+	return 0.0;
+}
+
+// does the bounding box lie entirely outside the escape disk
+static inline int8_t outside_escape_disk(const PlaneRect_double& abbx) {
+	if (escaperadius2 <= 0.0) return 0;
+	
+	const double dx=interval_distance0(abbx.x0,abbx.x1);
+	const double dy=interval_distance0(abbx.y0,abbx.y1);
+	
+	return (dx*dx + dy*dy) > escaperadius2;
+}
+
+static inline int8_t outside_escape_disk(const PlaneRect& abbx) {
+	if (escaperadius2 <= 0.0) return 0;
+	
+	PlaneRect_double d;
+	#ifdef _FPA
+	PlaneRect tmp=abbx;
+	d.x0=tmp.x0.convert_to_double();
+	d.x1=tmp.x1.convert_to_double();
+	d.y0=tmp.y0.convert_to_double();
+	d.y1=tmp.y1.convert_to_double();
+	#else
+	d.x0=(double)abbx.x0;
+	d.x1=(double)abbx.x1;
+	d.y0=(double)abbx.y0;
+	d.y1=(double)abbx.y1;
+	#endif
+	
+	return outside_escape_disk(d);
+}
+
+// outside the range or outside the escape disk: every point escapes
 #define SQUARE_LIES_ENTIRELY_IN_SPECEXT(BBX) \
 	(\
 		(BBX.x1 < COMPLETE0) ||\
 		(BBX.x0 > COMPLETE1) ||\
 		(BBX.y1 < COMPLETE0) ||\
-		(BBX.y0 > COMPLETE1)\
+		(BBX.y0 > COMPLETE1) ||\
+		(outside_escape_disk(BBX) > 0)\
 	)
 	
 #define SQUARE_LIES_ENTIRELY_OUTSIDE_GRAY_ENCLOSEMENT(BBX) \
@@ -1356,35 +2117,114 @@ inline int32_t minimumI(const int32_t a,const int32_t b,const int32_t c,const in
 
 // static reverse cell graph
 
-RevCGBlock::RevCGBlock() {
-	howmany=0;
-	memused=0;
-	containsgray=0;
+// index of the first tile in [afrom,aend) that is to be visited and
+// still contains gray, -1 if there is none
+static inline int64_t next_revcg_tile(const int64_t afrom,const int64_t aend) {
+	int64_t w=afrom >> 6;
+	int64_t wend=(aend+63) >> 6;
+	uint64_t bits=
+		(data5->revcgtovisit[w] & data5->revcgcontainsgray[w])
+		& (~(uint64_t)0 << (afrom & 63));
+	
+	while (bits == 0) {
+		if ((++w) >= wend) return -1;
+		bits=data5->revcgtovisit[w] & data5->revcgcontainsgray[w];
+	}
+	
+	int64_t idx=(w << 6) + __builtin_ctzll(bits);
+	if (idx >= aend) return -1;
+	
+	return idx;
 }
 
-void RevCGBlock::addParent(const int32_t ax,const int32_t ay) {
-	if (
-		(ax < 0) ||
-		(ay < 0) ||
-		(ax >= REVCGmaxnumber) ||
-		(ay >= REVCGmaxnumber) 
-	) {
-		LOGMSG3("Implementation error. Parent at %i,%i not valid.\n",ax,ay);
-		return; 
+// index of the last tile in [astart,afrom] that is to be visited and
+// still contains gray, -1 if there is none
+static inline int64_t prev_revcg_tile(const int64_t afrom,const int64_t astart) {
+	if (afrom < astart) return -1;
+	int64_t w=afrom >> 6;
+	int64_t wstart=astart >> 6;
+	uint64_t bits=
+		(data5->revcgtovisit[w] & data5->revcgcontainsgray[w])
+		& (~(uint64_t)0 >> (63 - (afrom & 63)));
+	
+	while (bits == 0) {
+		if ((--w) < wstart) return -1;
+		bits=data5->revcgtovisit[w] & data5->revcgcontainsgray[w];
 	}
 	
-	if (parent == NULL) {
-		parent=parentmgr->getParentSpace(memused);
-		howmany=0;
-		if (!parent) {
-			LOGMSG("Memory failure for parent.\n");
-			exit(99);
+	int64_t idx=(w << 6) + 63 - __builtin_clzll(bits);
+	if (idx < astart) return -1;
+	
+	return idx;
+}
+
+// tile position of the ad-th cell along the Hilbert curve
+// through an an x an grid, an a power of 2
+static inline void hilbert_d2xy(const int32_t an,int64_t ad,int32_t& x,int32_t& y) {
+	x=y=0;
+	for(int32_t s=1;s<an;s <<= 1) {
+		int32_t rx=1 & (ad >> 1);
+		int32_t ry=1 & (ad ^ rx);
+		if (ry == 0) {
+			if (rx == 1) {
+				x=s-1-x;
+				y=s-1-y;
+			}
+			int32_t t=x;
+			x=y;
+			y=t;
+		}
+		x += s*rx;
+		y += s*ry;
+		ad >>= 2;
+	}
+}
+
+// apass counts from 0, ALTERNATE runs odd passes backwards
+void RevCGOrder::start(
+	const int32_t aorder,const int32_t apass,
+	const int32_t arow0,const int32_t arow1
+) {
+	order=aorder;
+	row0=arow0;
+	row1=arow1;
+	from=(int64_t)row0*REVCGmaxnumber;
+	end=(int64_t)(row1+1)*REVCGmaxnumber;
+	if (row1 < row0) end=from;
+	backward=0;
+	if ( (order == ORDER_ALTERNATE) && ((apass & 1) != 0) ) backward=1;
+	
+	if (order == ORDER_HILBERT) cursor=0;
+	else if (backward>0) cursor=end-1;
+	else cursor=from;
+}
+
+int64_t RevCGOrder::next(void) {
+	int64_t idx;
+	if (order == ORDER_HILBERT) {
+		while (cursor < REVCGmaxnumberQ) {
+			int32_t bx,by;
+			hilbert_d2xy(REVCGmaxnumber,cursor,bx,by);
+			cursor++;
+			if ( (by < row0) || (by > row1) ) continue;
+			idx=(int64_t)by*REVCGmaxnumber+bx;
+			if (
+				REVCGGETBIT(data5->revcgtovisit,idx) &&
+				REVCGGETBIT(data5->revcgcontainsgray,idx)
+			) return idx;
 		}
+		return -1;
+	}
+	
+	if (backward>0) {
+		idx=prev_revcg_tile(cursor,from);
+		if (idx >= 0) cursor=idx-1;
+	} else {
+		idx=next_revcg_tile(cursor,end);
+		if (idx >= 0) cursor=idx+1;
 	}
 	
-	parent[howmany].BX=ax;
-	parent[howmany].BY=ay;
-	howmany++;
+	return idx;
 }
 
 void Data5::saveRaw(const char* afn) {
@@ -1394,36 +2234,16 @@ void Data5::saveRaw(const char* afn) {
 	DDBYTE w=SCREENWIDTH;
 	fwrite(&w,sizeof(w),1,f);
 	for(int32_t y=0;y<SCREENWIDTH;y++) {
-		if (memgrau[y].g0 <= memgrau[y].g1) {
-			// memg0 <= g0 <= g1 <= memg1
-			int32_t m0=SCREENWIDTH >> 4,m1=0;
-			for(int32_t mem=memgrau[y].mem0;mem<=memgrau[y].mem1;mem++) {
-				DDBYTE w;
-				GETDATA5BYMEM_MY(mem,y,w);
-				if (w != SQUARE_WHITE_16_CONSECUTIVE) {
-					if (mem < m0) m0=mem;
-					if (mem > m1) m1=mem;
-				}
-			}
-
-			int32_t laenge=m1-m0+1;
-			if (laenge>0) {
-				fwrite(&m0,1,sizeof(m0),f);
-				fwrite(&laenge,1,sizeof(laenge),f);
-				fwrite(
-					&zeilen[y][m0 - memgrau[y].mem0],
-					laenge,
-					sizeof(DDBYTE),
-				f);
-			} else {
-				// empty row
-				int32_t start=0,laenge=0;
-				fwrite(&start,1,sizeof(start),f);
-				fwrite(&laenge,1,sizeof(laenge),f);
-			}
+		// the file keeps one interval per row, gaps are written white
+		int32_t start=0;
+		int32_t laenge=getRowWords(y,rowbuffer,start);
+		if (laenge>0) {
+			fwrite(&start,1,sizeof(start),f);
+			fwrite(&laenge,1,sizeof(laenge),f);
+			fwrite(rowbuffer,laenge,sizeof(DDBYTE),f);
 		} else {
 			// empty row
-			int32_t start=0,laenge=0;
+			start=0;
 			fwrite(&start,1,sizeof(start),f);
 			fwrite(&laenge,1,sizeof(laenge),f);
 		}
@@ -1432,23 +2252,15 @@ void Data5::saveRaw(const char* afn) {
 	fclose(f);
 }
 
-// does a row contain interior cells
-int32_t interiorinrow(DDBYTE* aw,const int32_t alen) {
-	for(int32_t i=0;i<alen;i++) {
-		DDBYTE w=aw[i];
-		for(int bit=0;bit<16;bit++) {
-			if ((w & 0b11) == SQUARE_BLACK) {
-				//printf("read interior x=%i\n",((i<<4)+bit));
-				return 1;
-			}
-			w >>= 2;
-		}
-	}
-	return 0;
+// estimate in percent for how many gray cells are in a row of alen
+// integers of which agray are neither completely white nor black,
+// needed for guided precomputing bbx's
+static inline int graudensity_of(const int64_t agray,const int32_t alen) {
+	return (int)(100*(double)agray/(double)alen);
 }
 
 int32_t Data5::readRawBlowUp(void) {
-	FILE *f=fopen("_in.raw","rb");
+	FILE *f=fopen(INFN,"rb");
 	if (!f) {
 		printf("No stored data found. Computation starts anew.\n");
 		return 0;
@@ -1471,37 +2283,25 @@ int32_t Data5::readRawBlowUp(void) {
 			fread(&laenge,1,sizeof(laenge),f);
 			if (laenge<=0) {
 				zeilen[y]=NULL;
-				memgrau[y].g0=SCREENWIDTH;
-				memgrau[y].g1=0;
-				memgrau[y].mem0=(SCREENWIDTH >> 4);
-				memgrau[y].mem1=0;
+				memgrau[y].setEmpty();
 				graudensity[y]=0;
 			} else {
-				zeilen[y]=data5->datamgr->getMemory(laenge);
-				memused += (laenge*sizeof(DDBYTE));
-				if (!zeilen[y]) {
-					LOGMSG("Speicherfehler. ReadRaw\n");
-					exit(99);
-				}
-				fread(zeilen[y],laenge,sizeof(DDBYTE),f);
-				// is there at least 1 black cell ?
-				if (interiorpresent<=0) {
-					interiorpresent=interiorinrow(zeilen[y],laenge);
-				}
+				fread(eine,laenge,sizeof(DDBYTE),f);
+				// gray integers and whether there is at least
+				// 1 black cell in one pass
 				int64_t ctrgrau=0;
+				DDBYTE black=0;
 				for(int32_t dx=0;dx<laenge;dx++) {
+					const DDBYTE w=eine[dx];
+					black |= (w >> 1) & ~w;
 					if (
-						(zeilen[y][dx] != SQUARE_WHITE_16_CONSECUTIVE) &&
-						(zeilen[y][dx] != SQUARE_BLACK_16_CONSECUTIVE)
+						(w != SQUARE_WHITE_16_CONSECUTIVE) &&
+						(w != SQUARE_BLACK_16_CONSECUTIVE)
 					) ctrgrau++;
 				}
-				// estimate for how many gray cells are in this row
-				// needed for guided precomputing bbx's
-				graudensity[y]=(int)(100*(double)ctrgrau/(double)laenge);
-				memgrau[y].mem0=start;
-				memgrau[y].mem1=start+laenge-1;
-				memgrau[y].g0=memgrau[y].mem0 << 4;
-				memgrau[y].g1=((memgrau[y].mem1+1) << 4)-1;
+				if (black & LANES_LOWBIT) interiorpresent=1;
+				graudensity[y]=graudensity_of(ctrgrau,laenge);
+				memused += setRowWords(y,eine,start,laenge);
 				if (y < encgrayy0) encgrayy0=y;
 				if (y > encgrayy1) encgrayy1=y;
 				if (memgrau[y].g0 < encgrayx0) encgrayx0=memgrau[y].g0;
@@ -1514,64 +2314,11 @@ int32_t Data5::readRawBlowUp(void) {
 			fread(&start,1,sizeof(start),f);
 			fread(&laenge,1,sizeof(laenge),f);
 			if (laenge<=0) {
-				zeilen[yread]=zeilen[yread+1]=NULL;
-				graudensity[yread]=0;
-				graudensity[yread+1]=0;
-				memgrau[yread].g0=memgrau[yread+1].g0=SCREENWIDTH;
-				memgrau[yread].g1=memgrau[yread+1].g1=0;
-				memgrau[yread].mem0=memgrau[yread+1].mem0=SCREENWIDTH >> 4;
-				memgrau[yread].mem1=memgrau[yread+1].mem1=0;
+				setRowPairEmpty(yread);
 			} else {
 				// one cell into a 2x2 grid - refinement process
-				int32_t readlaenge=laenge;
-				laenge <<= 1;
-				start <<= 1;
-				zeilen[yread]=data5->datamgr->getMemory(laenge);
-				zeilen[yread+1]=data5->datamgr->getMemory(laenge);
-				memused += (2*laenge*sizeof(DDBYTE));
-				if (!zeilen[yread+1]) {
-					LOGMSG("Memory error. ReadRaw\n");
-					exit(99);
-				}
-				fread(eine,readlaenge,sizeof(int32_t),f);
-				if (interiorpresent<=0) {
-					interiorpresent=interiorinrow(eine,readlaenge);
-				}
-				
-				int64_t ctrgrau=0;
-				for(int32_t dx=0;dx<readlaenge;dx++) {
-					if (
-						(eine[dx] != SQUARE_WHITE_16_CONSECUTIVE) &&
-						(eine[dx] != SQUARE_BLACK_16_CONSECUTIVE)
-					) ctrgrau++;
-				}
-				// estimate for how many gray cells are in this row
-				int grd=(int)(100*(double)ctrgrau/(double)readlaenge);
-				graudensity[yread]=grd;
-				graudensity[yread+1]=grd;
-
-				DDBYTE mem=0;
-				for(int32_t k=0;k<readlaenge;k++) {
-					// substitute POTWGRAU with GRAY
-					// as potentially-white-information cannot be blowed-up
-					DDBYTE ziel[2];
-					copy_pixel_to_2x2grid(eine[k],ziel);
-					data5->zeilen[yread][mem]=ziel[0];
-					data5->zeilen[yread][mem+1]=ziel[1];
-					data5->zeilen[yread+1][mem]=ziel[0];
-					data5->zeilen[yread+1][mem+1]=ziel[1];
-					mem += 2;
-				} 
-				
-				memgrau[yread].mem0=memgrau[yread+1].mem0=start;
-				memgrau[yread].mem1=memgrau[yread+1].mem1=start+laenge-1;
-				memgrau[yread].g0=memgrau[yread+1].g0=(memgrau[yread].mem0 << 4);
-				memgrau[yread].g1=memgrau[yread+1].g1=((memgrau[yread].mem1+1) << 4)-1;
-
-				if (yread < encgrayy0) encgrayy0=yread;
-				if ( (yread+1) > encgrayy1) encgrayy1=(yread+1);
-				if (memgrau[yread].g0 < encgrayx0) encgrayx0=memgrau[yread].g0;
-				if (memgrau[yread].g1 > encgrayx1) encgrayx1=memgrau[yread].g1;
+				fread(eine,laenge,sizeof(int32_t),f);
+				memused += setRowPairBlowUp(yread,eine,start,laenge);
 			} // 2x2 gird
 		} // yread 
 	} else {
@@ -1595,25 +2342,596 @@ int32_t Data5::readRawBlowUp(void) {
 	if (_RESETPOTW>0) {
 		// reset all potw to gray so a new propagate_XXX pass can be started fresh
 		printf("resetting potw to gray ... ");
-		color_changeS32(
-			SQUARE_GRAY_POTENTIALLY_WHITE,
-			SQUARE_GRAY,
-			SQUARE_GRAYPOTW_16_CONSECUTIVE,
-			SQUARE_GRAY_16_CONSECUTIVE
-		);
+		color_changeS32(SQUARE_GRAY_POTENTIALLY_WHITE,SQUARE_GRAY);
 		printf("\n");
 	}
 	
 	return 1;
 }
 
-void Data5::saveBitmap4_twd(const char* afn,const int atwdexp) {
-	// saves a trustworthily downsized version of the image: 16-fold. 
-	// image format is: 8 bit Bitmap
-	// 2^TWDEXP x 2^TWDEXP gives one final pixel
-	
-	int32_t _TWDEXPONENT=atwdexp;
-
+// rows ay and ay+1 stay white
+void Data5::setRowPairEmpty(const int32_t ay) {
+	zeilen[ay]=zeilen[ay+1]=NULL;
+	graudensity[ay]=0;
+	graudensity[ay+1]=0;
+	memgrau[ay].setEmpty();
+	memgrau[ay+1].setEmpty();
+}
+
+// white gaps of at least GRAYSPAN_MINGAP integers split the alen integers
+// aw (integer astart is aw[0]) into spans, so do black gaps if _BLACKGAPS
+// is set. A gap is bordered by stored integers on both sides. The integers
+// lie between gaps of the colors ablackbefore and ablackafter (white for
+// a whole row), leading and trailing integers of the respective color
+// join those gaps. Span offsets are positions in aw. Returns the number
+// of spans
+static int32_t split_into_grayspans(
+	const DDBYTE* aw,const int32_t astart,const int32_t alen,
+	GraySpan* aspans,const int8_t ablackbefore,const int8_t ablackafter
+) {
+	const DDBYTE lead=(ablackbefore > 0) ? SQUARE_BLACK_16_CONSECUTIVE : SQUARE_WHITE_16_CONSECUTIVE;
+	const DDBYTE trail=(ablackafter > 0) ? SQUARE_BLACK_16_CONSECUTIVE : SQUARE_WHITE_16_CONSECUTIVE;
+	int32_t s=0,e=alen-1;
+	while ( (s < alen) && (aw[s] == lead) ) s++;
+	while ( (e >= 0) && (aw[e] == trail) ) e--;
+	if (s > e) {
+		// the integers join the gaps. If those differ in color,
+		// one integer is kept as their border
+		if (ablackbefore == ablackafter) return 0;
+		if (s < alen) e=s; else s=e;
+	}
+	
+	int32_t anz=0;
+	int8_t gapblack=ablackbefore;
+	int8_t newspan=1;
+	int32_t i=s;
+	while (i <= e) {
+		const DDBYTE w=aw[i];
+		int32_t j=i+1;
+		if (
+			(i > s) &&
+			(
+				(w == SQUARE_WHITE_16_CONSECUTIVE) ||
+				( (w == SQUARE_BLACK_16_CONSECUTIVE) && (_BLACKGAPS > 0) )
+			)
+		) {
+			// run of one color, integers s and e are kept
+			while ( (j < e) && (aw[j] == w) ) j++;
+			if ( (newspan <= 0) && ( (j-i) >= GRAYSPAN_MINGAP) ) {
+				gapblack=(w == SQUARE_BLACK_16_CONSECUTIVE) ? 1 : 0;
+				newspan=1;
+				i=j;
+				continue;
+			}
+		}
+		
+		if (newspan > 0) {
+			aspans[anz].mem0=astart+i;
+			aspans[anz].offset=i;
+			aspans[anz].blackbefore=gapblack;
+			anz++;
+			newspan=0;
+		}
+		aspans[anz-1].mem1=astart+j-1;
+		i=j;
+	} // i
+	
+	return anz;
+}
+
+// row ay gets the gray spans of alen integers (integer astart is
+// awords[0]), only the integers in spans are allocated
+// returns bytes allocated
+int64_t Data5::setRowWords(
+	const int32_t ay,const DDBYTE* awords,
+	const int32_t astart,const int32_t alen
+) {
+	const int32_t anz=split_into_grayspans(awords,astart,alen,spanbuffer,0,0);
+	if (anz <= 0) {
+		zeilen[ay]=NULL;
+		memgrau[ay].setEmpty();
+		return 0;
+	}
+	
+	int32_t laenge=0;
+	for(int32_t i=0;i<anz;i++) {
+		laenge += (spanbuffer[i].mem1-spanbuffer[i].mem0+1);
+	}
+	
+	zeilen[ay]=datamgr->getMemory(laenge);
+	memgrau[ay].spans=spanmgr->getMemory(anz);
+	if ( (!zeilen[ay]) || (!memgrau[ay].spans) ) {
+		LOGMSG("Memory error. setRowWords\n");
+		fatal_exit(99);
+	}
+	
+	laenge=0;
+	for(int32_t i=0;i<anz;i++) {
+		const int32_t len=spanbuffer[i].mem1-spanbuffer[i].mem0+1;
+		memcpy(
+			&zeilen[ay][laenge],
+			&awords[spanbuffer[i].offset],
+			len*sizeof(DDBYTE)
+		);
+		spanbuffer[i].offset=laenge;
+		laenge += len;
+	}
+	
+	memcpy(memgrau[ay].spans,spanbuffer,anz*sizeof(GraySpan));
+	memgrau[ay].anzspans=memgrau[ay].spanmemused=anz;
+	memgrau[ay].settled=0;
+	memgrau[ay].setEnclosement();
+	
+	return laenge*sizeof(DDBYTE) + anz*sizeof(GraySpan);
+}
+
+// row ay gets its own copy of the words and spans of row asrc
+int64_t Data5::setRowCopy(const int32_t ay,const int32_t asrc) {
+	const int32_t anz=memgrau[asrc].anzspans;
+	if ( (!zeilen[asrc]) || (anz <= 0) ) {
+		zeilen[ay]=NULL;
+		memgrau[ay].setEmpty();
+		return 0;
+	}
+	
+	const int32_t laenge=memgrau[asrc].words();
+	zeilen[ay]=datamgr->getMemory(laenge);
+	memgrau[ay].spans=spanmgr->getMemory(anz);
+	if ( (!zeilen[ay]) || (!memgrau[ay].spans) ) {
+		LOGMSG("Memory error. setRowCopy\n");
+		fatal_exit(99);
+	}
+	
+	memcpy(zeilen[ay],zeilen[asrc],laenge*sizeof(DDBYTE));
+	memcpy(memgrau[ay].spans,memgrau[asrc].spans,anz*sizeof(GraySpan));
+	memgrau[ay].anzspans=memgrau[ay].spanmemused=anz;
+	memgrau[ay].settled=0;
+	memgrau[ay].setEnclosement();
+	
+	return laenge*sizeof(DDBYTE) + anz*sizeof(GraySpan);
+}
+
+// the non-white integers of row ay as one interval into awords,
+// gaps between spans are filled with their color. Returns the length,
+// 0 if the row is white
+int32_t Data5::getRowWords(const int32_t ay,DDBYTE* awords,int32_t& astart) {
+	if ( (!zeilen[ay]) || (memgrau[ay].anzspans <= 0) ) return 0;
+	
+	// spans may have become white since the last tightening
+	int32_t m0=-1,m1=-1;
+	for(int32_t i=0;i<memgrau[ay].anzspans;i++) {
+		const GraySpan* sp=&memgrau[ay].spans[i];
+		for(int32_t mem=sp->mem0;mem<=sp->mem1;mem++) {
+			if (zeilen[ay][sp->offset+mem-sp->mem0] == SQUARE_WHITE_16_CONSECUTIVE) continue;
+			if (m0 < 0) m0=mem;
+			m1=mem;
+		}
+	}
+	
+	if (m0 < 0) return 0;
+	
+	astart=m0;
+	for(int32_t mem=m0;mem<=m1;mem++) {
+		const int32_t woffset=grayword_offset(memgrau[ay],mem);
+		if (woffset >= 0) awords[mem-m0]=zeilen[ay][woffset];
+		else awords[mem-m0]=gapword(memgrau[ay],mem);
+	}
+	
+	return m1-m0+1;
+}
+
+// row ay is one span over the whole width, used before the special
+// exterior is searched
+void Data5::setRowFull(const int32_t ay) {
+	memgrau[ay].spans=spanmgr->getMemory(1);
+	if (!memgrau[ay].spans) {
+		LOGMSG("Memory error. setRowFull\n");
+		fatal_exit(99);
+	}
+	memgrau[ay].spans[0].mem0=0;
+	memgrau[ay].spans[0].mem1=(SCREENWIDTH >> 4)-1;
+	memgrau[ay].spans[0].offset=0;
+	memgrau[ay].spans[0].blackbefore=0;
+	memgrau[ay].anzspans=memgrau[ay].spanmemused=1;
+	memgrau[ay].settled=0;
+	memgrau[ay].setEnclosement();
+}
+
+// drops integers that became white (or black) and splits spans at new
+// gaps. Integers only move towards the row start, so this is done in
+// place, precomputed screen rects move along
+void Data5::tightenRow(const int32_t ay) {
+	Gray_in_row* mg=&memgrau[ay];
+	mg->settled=0;
+	if ( (!zeilen[ay]) || (mg->anzspans <= 0) ) return;
+	
+	int32_t anz=0;
+	for(int32_t i=0;i<mg->anzspans;i++) {
+		const GraySpan* sp=&mg->spans[i];
+		int32_t neu=split_into_grayspans(
+			&zeilen[ay][sp->offset],sp->mem0,
+			sp->mem1-sp->mem0+1,&spanbuffer[anz],
+			sp->blackbefore,
+			(i < (mg->anzspans-1)) ? mg->spans[i+1].blackbefore : 0
+		);
+		for(int32_t k=anz;k<(anz+neu);k++) spanbuffer[k].offset += sp->offset;
+		anz += neu;
+	}
+	
+	PScreenRect pc=NULL;
+	if (pcscr) pc=pcscr[ay];
+	
+	int32_t laenge=0;
+	for(int32_t i=0;i<anz;i++) {
+		const int32_t von=spanbuffer[i].offset;
+		const int32_t len=spanbuffer[i].mem1-spanbuffer[i].mem0+1;
+		if (von != laenge) {
+			memmove(&zeilen[ay][laenge],&zeilen[ay][von],len*sizeof(DDBYTE));
+			if (pc) {
+				memmove(&pc[laenge << 4],&pc[von << 4],(len << 4)*sizeof(ScreenRect));
+			}
+		}
+		spanbuffer[i].offset=laenge;
+		laenge += len;
+	}
+	
+	if (anz <= 0) {
+		mg->setEmpty();
+		return;
+	}
+	
+	if (anz > mg->spanmemused) {
+		mg->spans=spanmgr->getMemory(anz);
+		if (!mg->spans) {
+			LOGMSG("Memory error. tightenRow\n");
+			fatal_exit(99);
+		}
+		mg->spanmemused=anz;
+	}
+	memcpy(mg->spans,spanbuffer,anz*sizeof(GraySpan));
+	mg->anzspans=anz;
+	mg->setEnclosement();
+}
+
+struct RowPosition {
+	int32_t chunk;
+	int64_t offset;
+	int32_t y;
+};
+
+static int compare_rowposition(const void* a,const void* b) {
+	const RowPosition* pa=(const RowPosition*)a;
+	const RowPosition* pb=(const RowPosition*)b;
+	if (pa->chunk != pb->chunk) return (pa->chunk < pb->chunk) ? -1 : 1;
+	if (pa->offset != pb->offset) return (pa->offset < pb->offset) ? -1 : 1;
+	
+	return 0;
+}
+
+// slides the rows' integers towards the start of the row memory in
+// allocation order and gives the chunks no longer needed back to the
+// operating system. Rows only ever move to lower positions, so no
+// second arena is needed. Nothing is done unless at least one chunk
+// can be released. Returns bytes released
+int64_t Data5::compactMemory(void) {
+	const int64_t CHUNKWORDS=datamgr->allokierePerBlockIdx;
+	int64_t live=0;
+	int32_t anzrows=0;
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		if (!zeilen[y]) continue;
+		if (memgrau[y].anzspans <= 0) {
+			// tightened to white
+			zeilen[y]=NULL;
+			continue;
+		}
+		anzrows++;
+		// mirrored rows share their memory
+		if ( (y >= (SCREENWIDTH >> 1)) && (zeilen[SCREENWIDTH-1-y] == zeilen[y]) ) continue;
+		live += (memgrau[y].words()+2);
+	}
+	
+	// one integer row of waste at every chunk end at most
+	int64_t needed=1+(live+((int64_t)SCREENWIDTH >> 4)*(live/CHUNKWORDS+1))/CHUNKWORDS;
+	if (needed >= datamgr->anzptr) return 0;
+	
+	RowPosition* pos=new RowPosition[anzrows];
+	int32_t anz=0;
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		if (!zeilen[y]) continue;
+		pos[anz].chunk=datamgr->chunkOf(zeilen[y]);
+		if (pos[anz].chunk < 0) {
+			LOGMSG("Implementation error. compactMemory\n");
+			fatal_exit(99);
+		}
+		pos[anz].offset=zeilen[y]-datamgr->ptr[pos[anz].chunk];
+		pos[anz].y=y;
+		anz++;
+	}
+	qsort(pos,anz,sizeof(RowPosition),compare_rowposition);
+	
+	int32_t chunk=0;
+	int32_t frei=0;
+	DDBYTE* last=NULL;
+	for(int32_t i=0;i<anz;i++) {
+		const int32_t y=pos[i].y;
+		if ( 
+			(i > 0) &&
+			(pos[i].chunk == pos[i-1].chunk) &&
+			(pos[i].offset == pos[i-1].offset)
+		) {
+			// same memory as the row before
+			zeilen[y]=last;
+			continue;
+		}
+		
+		const int32_t len=memgrau[y].words();
+		if ( (frei+len+2) >= CHUNKWORDS ) {
+			chunk++;
+			frei=0;
+		}
+		DDBYTE* ziel=&datamgr->ptr[chunk][frei];
+		if (ziel != zeilen[y]) memmove(ziel,zeilen[y],len*sizeof(DDBYTE));
+		zeilen[y]=last=ziel;
+		frei += len;
+	} // i
+	
+	delete[] pos;
+	
+	return datamgr->releaseAfter(chunk,frei);
+}
+
+// tightens all rows (aall>0) or only those where integers became white
+// (or black).
+// A row sharing its memory with the mirrored row is tightened once
+void Data5::tightenRows(const int8_t aall) {
+	const int32_t HALF=SCREENWIDTH >> 1;
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		const int32_t ym=SCREENWIDTH-1-y;
+		int8_t shared=0;
+		if ( (zeilen[y]) && (zeilen[ym] == zeilen[y]) && (ym != y) ) {
+			if (y >= HALF) continue;
+			shared=1;
+		}
+		
+		if (
+			(aall <= 0) &&
+			(memgrau[y].settled <= 0) &&
+			( (shared <= 0) || (memgrau[ym].settled <= 0) )
+		) continue;
+		
+		tightenRow(y);
+		if (shared > 0) memgrau[ym]=memgrau[y];
+	} // y
+}
+
+// one coarse row (alen words starting at word astart of the half
+// resolution) is blown up into rows ay and ay+1 at the current resolution
+// returns bytes allocated
+int64_t Data5::setRowPairBlowUp(
+	const int32_t ay,DDBYTE* acoarse,
+	const int32_t astart,const int32_t alen
+) {
+	int32_t laenge=alen << 1;
+	int32_t start=astart << 1;
+	
+	// blow-up, gray statistics and interior in one pass
+	int64_t ctrgrau=0;
+	DDBYTE black=0;
+	for(int32_t k=0;k<alen;k++) {
+		const DDBYTE w=acoarse[k];
+		black |= (w >> 1) & ~w;
+		if (
+			(w != SQUARE_WHITE_16_CONSECUTIVE) &&
+			(w != SQUARE_BLACK_16_CONSECUTIVE)
+		) ctrgrau++;
+		// substitute POTWGRAU with GRAY
+		// as potentially-white-information cannot be blowed-up
+		copy_pixel_to_2x2grid(w,&rowbuffer[k << 1]);
+	} 
+	if (black & LANES_LOWBIT) interiorpresent=1;
+	const int grd=graudensity_of(ctrgrau,alen);
+	graudensity[ay]=grd;
+	graudensity[ay+1]=grd;
+	
+	// both rows are equal, they are split into spans once
+	int64_t memused=setRowWords(ay,rowbuffer,start,laenge);
+	memused += setRowCopy(ay+1,ay);
+	if (memgrau[ay].anzspans <= 0) return memused;
+
+	if (ay < encgrayy0) encgrayy0=ay;
+	if ( (ay+1) > encgrayy1) encgrayy1=(ay+1);
+	if (memgrau[ay].g0 < encgrayx0) encgrayx0=memgrau[ay].g0;
+	if (memgrau[ay].g1 > encgrayx1) encgrayx1=memgrau[ay].g1;
+	
+	return memused;
+}
+
+// in-memory counterpart of readRawBlowUp for LEVELS=
+// acoarse holds the image at half the current resolution, its rows
+// are trimmed to the non-white words as saveRaw does, so the result
+// equals a saveRaw/readRawBlowUp round trip
+int32_t Data5::refineFrom(Data5* acoarse) {
+	const int32_t coarsewidth=SCREENWIDTH >> 1;
+	encgrayx0=encgrayy0=SCREENWIDTH-1;
+	encgrayx1=encgrayy1=0;
+	interiorpresent=0;
+	int64_t memused=0;
+	
+	printf("refining in memory ");
+
+	for(int32_t yread=0;yread<coarsewidth;yread++) {
+		int32_t m0=0;
+		int32_t laenge=acoarse->getRowWords(yread,acoarse->rowbuffer,m0);
+		
+		if (laenge<=0) {
+			setRowPairEmpty(yread << 1);
+		} else {
+			memused += setRowPairBlowUp(
+				yread << 1,
+				acoarse->rowbuffer,
+				m0,laenge
+			);
+		}
+	} // yread
+	
+	printf("\n  %I64d GB cell memory allocated\n",1+(memused >> 30));
+	
+	// outward rounded enclosement of all gray
+	planegrayx0=encgrayx0*scaleRangePerPixel + COMPLETE0;
+	planegrayy0=encgrayy0*scaleRangePerPixel + COMPLETE0;
+	planegrayx1=(encgrayx1+16)*scaleRangePerPixel + COMPLETE0;
+	planegrayy1=(encgrayy1+16)*scaleRangePerPixel + COMPLETE0;
+	
+	// potw is already turned into gray by the 2x2 blow-up
+	
+	return 1;
+}
+
+// window mode: the window's rows take the colors of the coarse image
+// (potw as gray), all other rows stay empty as scan_rect_colors reads
+// them from the oracle. The gray enclosement is that of the whole
+// coarse image, everything outside it is white
+int32_t Data5::setupWindow(void) {
+	WindowOracle* wo=windoworacle;
+	interiorpresent=0;
+	int64_t memused=0;
+
+	printf("setting up window from coarse image ");
+
+	const int32_t m0=wo->x0 >> 4;
+	const int32_t laenge=((wo->x1 - wo->x0) >> 4) + 1;
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		if ( (y < wo->y0) || (y > wo->y1) ) {
+			zeilen[y]=NULL;
+			memgrau[y].setEmpty();
+			graudensity[y]=0;
+			continue;
+		}
+
+		const int32_t cy=y >> wo->shift;
+		int64_t ctrgrau=0;
+		for(int32_t i=0;i<laenge;i++) {
+			DDBYTE w=0;
+			const int32_t xw=(m0+i) << 4;
+			for(int32_t bit=15;bit>=0;bit--) {
+				int32_t f=wo->colorAt((xw+bit) >> wo->shift,cy);
+				if (f == SQUARE_GRAY_POTENTIALLY_WHITE) f=SQUARE_GRAY;
+				if (f == SQUARE_BLACK) interiorpresent=1;
+				w=(w << 2) | f;
+			}
+			rowbuffer[i]=w;
+			if (
+				(w != SQUARE_WHITE_16_CONSECUTIVE) &&
+				(w != SQUARE_BLACK_16_CONSECUTIVE)
+			) ctrgrau++;
+		} // i
+
+		graudensity[y]=(int)(100*(double)ctrgrau/(double)laenge);
+		memused += setRowWords(y,rowbuffer,m0,laenge);
+	} // y
+
+	printf("\n  %I64d GB cell memory allocated\n",1+(memused >> 30));
+
+	// coarse pixels blown up, outward to whole integers
+	encgrayx0=(wo->cx0 << wo->shift) & ~0b1111;
+	encgrayy0=(wo->cy0 << wo->shift) & ~0b1111;
+	encgrayx1=((((wo->cx1+1) << wo->shift) + 15) & ~0b1111) - 16;
+	encgrayy1=((((wo->cy1+1) << wo->shift) + 15) & ~0b1111) - 16;
+	if (encgrayx1 > (SCREENWIDTH-16)) encgrayx1=SCREENWIDTH-16;
+	if (encgrayy1 > (SCREENWIDTH-16)) encgrayy1=SCREENWIDTH-16;
+	planegrayx0=encgrayx0*scaleRangePerPixel + COMPLETE0;
+	planegrayy0=encgrayy0*scaleRangePerPixel + COMPLETE0;
+	planegrayx1=(encgrayx1+16)*scaleRangePerPixel + COMPLETE0;
+	planegrayy1=(encgrayy1+16)*scaleRangePerPixel + COMPLETE0;
+
+	return 1;
+}
+
+// upper half rows become aliases of their mirrored lower half rows,
+// so every write to row y is a write to row SCREENWIDTH-1-y as well
+void Data5::foldSymmetric(void) {
+	const int32_t HALF=SCREENWIDTH >> 1;
+	for(int32_t y=0;y<HALF;y++) {
+		int32_t ym=SCREENWIDTH-1-y;
+		if (zeilen[ym]==zeilen[y]) {
+			// memory was already shared by find_special_exterior:
+			// both rows span the whole width, gray enclosement is the union
+			if (memgrau[ym].g0 < memgrau[y].g0) memgrau[y].g0=memgrau[ym].g0;
+			if (memgrau[ym].g1 > memgrau[y].g1) memgrau[y].g1=memgrau[ym].g1;
+			if (graudensity[ym] > graudensity[y]) graudensity[y]=graudensity[ym];
+		}
+		// otherwise the lower row is valid for its mirror image as well
+		zeilen[ym]=zeilen[y];
+		memgrau[ym]=memgrau[y];
+		graudensity[ym]=graudensity[y];
+	} // y
+	
+	// gray enclosement symmetric to the real axis
+	int32_t y0=encgrayy0,y1=encgrayy1;
+	if ( (SCREENWIDTH-16-y1) < y0) y0=SCREENWIDTH-16-y1;
+	if ( (SCREENWIDTH-16-encgrayy0) > y1) y1=SCREENWIDTH-16-encgrayy0;
+	if (y0 < 0) y0=0;
+	if (y1 > (SCREENWIDTH-16)) y1=SCREENWIDTH-16;
+	encgrayy0=y0;
+	encgrayy1=y1;
+	planegrayy0=encgrayy0*scaleRangePerPixel + COMPLETE0;
+	planegrayy1=(encgrayy1+16)*scaleRangePerPixel + COMPLETE0;
+}
+
+// gives every upper half row its own memory again, needed before
+// rows are changed independently, e.g. in the periodicity check
+void Data5::unfoldSymmetric(void) {
+	const int32_t HALF=SCREENWIDTH >> 1;
+	for(int32_t y=0;y<HALF;y++) {
+		int32_t ym=SCREENWIDTH-1-y;
+		if ( (!zeilen[y]) || (zeilen[ym] != zeilen[y]) ) continue;
+		int32_t laenge=memgrau[y].words();
+		if (laenge <= 0) {
+			zeilen[ym]=NULL;
+			memgrau[ym].setEmpty();
+			continue;
+		}
+		zeilen[ym]=datamgr->getMemory(laenge);
+		memgrau[ym].spans=spanmgr->getMemory(memgrau[y].anzspans);
+		if ( (!zeilen[ym]) || (!memgrau[ym].spans) ) {
+			LOGMSG("Memory error. unfoldSymmetric\n");
+			fatal_exit(99);
+		}
+		memcpy(zeilen[ym],zeilen[y],laenge*sizeof(DDBYTE));
+		memcpy(memgrau[ym].spans,memgrau[y].spans,memgrau[y].anzspans*sizeof(GraySpan));
+		memgrau[ym].spanmemused=memgrau[y].anzspans;
+	} // y
+}
+
+// black gaps become stored integers again, needed before pixels are
+// changed regardless of their color, e.g. in the periodicity check
+void Data5::storeBlackGaps(void) {
+	_BLACKGAPS=0;
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		int8_t black=0;
+		for(int32_t i=1;i<memgrau[y].anzspans;i++) {
+			if (memgrau[y].spans[i].blackbefore > 0) {
+				black=1;
+				break;
+			}
+		}
+		if (black <= 0) continue;
+		
+		int32_t start=0;
+		int32_t laenge=getRowWords(y,rowbuffer,start);
+		setRowWords(y,rowbuffer,start,laenge);
+	} // y
+	
+	compactMemory();
+}
+
+void Data5::saveBitmap4_twd(const char* afn,const int atwdexp) {
+	// saves a trustworthily downsized version of the image: 16-fold. 
+	// image format is: 8 bit Bitmap
+	// 2^TWDEXP x 2^TWDEXP gives one final pixel
+	
+	int32_t _TWDEXPONENT=atwdexp;
+
 	if (atwdexp<0) {
 		// adjust exponent, so final image is at most 2^16 x 2^16
 		_TWDEXPONENT=0;
@@ -1623,15 +2941,29 @@ void Data5::saveBitmap4_twd(const char* afn,const int atwdexp) {
 	int32_t TWDSTEP=(1 << _TWDEXPONENT);
 	char tmp[1024];
 	RGB4 pal[256];
-	int32_t bytes_per_row = SCREENWIDTH >> _TWDEXPONENT;
+	// in window mode only the window is saved
+	int32_t px0=0,px1=SCREENWIDTH-1,py0=0,py1=SCREENWIDTH-1;
+	if (windoworacle) {
+		px0=windoworacle->x0;
+		px1=windoworacle->x1;
+		py0=windoworacle->y0;
+		py1=windoworacle->y1;
+	}
+	int32_t bmpwidth=(px1-px0+1) >> _TWDEXPONENT;
+	int32_t bmpheight=(py1-py0+1) >> _TWDEXPONENT;
+	if (bmpwidth < 1) bmpwidth=1;
+	if (bmpheight < 1) bmpheight=1;
+	// bitmap rows are padded to 4 bytes
+	int32_t bytes_per_row = (bmpwidth+3) & ~0b11;
 	uint8_t* rgbz=new uint8_t[bytes_per_row];
+	for(int32_t i=0;i<bytes_per_row;i++) rgbz[i]=0;
 	uint32_t off
 		=	14 // size of file header
 		+	40 // size of bitmap header
 		+	256*4; // palette entries
 	uint32_t filelen
 		=	off
-		+	(bytes_per_row*bytes_per_row);
+		+	(bytes_per_row*bmpheight);
 	
 	for(int32_t i=0;i<256;i++) pal[i].R=pal[i].G=pal[i].B=pal[i].alpha=63;
 	pal[SQUARE_GRAY].R=127;
@@ -1651,7 +2983,7 @@ void Data5::saveBitmap4_twd(const char* afn,const int atwdexp) {
 	FILE *fbmp=fopen(tmp,"wb");
 	if (!fbmp) {
 		LOGMSG("Abort error. saveBitmap4_twd.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	
 	write2(fbmp,66,77); 
@@ -1659,8 +2991,8 @@ void Data5::saveBitmap4_twd(const char* afn,const int atwdexp) {
 	write4(fbmp,0,0,0,0); 
 	fwrite(&off,1,sizeof(off),fbmp); 
 	write4(fbmp,40,0,0,0); 
-	fwrite(&bytes_per_row,sizeof(bytes_per_row),1,fbmp);
-	fwrite(&bytes_per_row,sizeof(bytes_per_row),1,fbmp);
+	fwrite(&bmpwidth,sizeof(bmpwidth),1,fbmp);
+	fwrite(&bmpheight,sizeof(bmpheight),1,fbmp);
 	write2(fbmp,1,0);
 	write2(fbmp,8,0);
 	write4(fbmp,0,0,0,0);
@@ -1672,52 +3004,65 @@ void Data5::saveBitmap4_twd(const char* afn,const int atwdexp) {
 
 	for(int32_t i=0;i<256;i++) write4(fbmp,pal[i].B,pal[i].G,pal[i].R,pal[i].alpha);
 	
-	for(int32_t y=0;y<SCREENWIDTH;y+=TWDSTEP) {
-		int32_t xzeile=-1;
-		for(int32_t x=0;x<SCREENWIDTH;x+=TWDSTEP) {
-			xzeile++;
+	// final pixels are combined row by row, every row is read
+	// as one interval of 32bit integers
+	int32_t* finalf=new int32_t[bmpwidth];
+	for(int32_t y=py0;y<=py1;y+=TWDSTEP) {
+		for(int32_t i=0;i<bmpwidth;i++) finalf[i]=-1;
+		
+		for(int32_t dy=0;dy<TWDSTEP;dy++) {
+			// a window narrower than one final pixel
+			if ( (y+dy) > py1) break;
+			int32_t start=0;
+			int32_t laenge=getRowWords(y+dy,rowbuffer,start);
 			
-			int32_t finalf=-1;
-			for(int32_t dy=0;dy<TWDSTEP;dy++) {
-				for(int32_t dx=0;dx<TWDSTEP;dx++) {
-					int32_t f;
-					GET_SINGLE_CELLCOLOR_XY(x+dx,y+dy,f);
-					if (f == SQUARE_GRAY_POTENTIALLY_WHITE) {
-						finalf=SQUARE_GRAY;
-						break;
-					}
-					
-					if (finalf<0) finalf=f;
-					else if (finalf != f) {
-						finalf=SQUARE_GRAY;
-						break;
-					} 
-					
-					if (finalf == SQUARE_GRAY) break;
-				}
-
-				if (finalf == SQUARE_GRAY) break;
-			} // dy
+			for(int32_t x=px0;x<=px1;x++) {
+				int32_t* ff=&finalf[(x-px0) >> _TWDEXPONENT];
+				if (*ff == SQUARE_GRAY) continue;
+				
+				int32_t mem=x >> 4;
+				DDBYTE w=SQUARE_WHITE_16_CONSECUTIVE;
+				if ( (mem >= start) && (mem < (start+laenge)) ) w=rowbuffer[mem-start];
+				int32_t f=(w >> ((x & 0b1111) << 1)) & 0b11;
+				
+				if (f == SQUARE_GRAY_POTENTIALLY_WHITE) *ff=SQUARE_GRAY;
+				else if (*ff < 0) *ff=f;
+				else if (*ff != f) *ff=SQUARE_GRAY;
+			} // x
+		} // dy
 
-			rgbz[xzeile]=finalf;
-		} // x
+		for(int32_t i=0;i<bmpwidth;i++) rgbz[i]=finalf[i];
 		
 		fwrite(rgbz,bytes_per_row,sizeof(uint8_t),fbmp);
 	} // y
 	
 	fclose(fbmp);
 				
+	delete[] finalf;
 	delete[] rgbz;
 }
 
 Data5::Data5() {
 	printf("initialising main object ...\n");
 	
-	vgridYX=NULL;
 	memgrau=new Gray_in_row[SCREENWIDTH];
+	for(int32_t i=0;i<SCREENWIDTH;i++) memgrau[i].setEmpty();
 	zeilen=new uint32_t*[SCREENWIDTH];
-	revcgYX=new RevCGBlock[REVCGmaxnumber*REVCGmaxnumber];
-	datamgr=new ArrayDDByteManager;
+	spanmgr=new GraySpanManager;
+	rowbuffer=new DDBYTE[(SCREENWIDTH >> 4)+1];
+	spanbuffer=new GraySpan[(SCREENWIDTH >> 4)+1];
+	revcgoffset=new uint32_t[(int64_t)(REVCGmaxnumber+1)*REVCGmaxnumber];
+	revcgparents=new PParent[REVCGmaxnumber];
+	revcgtovisit=new uint64_t[(REVCGmaxnumberQ >> 6)+1];
+	revcgcontainsgray=new uint64_t[(REVCGmaxnumberQ >> 6)+1];
+	// only lower half tiles are parents under symmetry
+	revcgimage=new ScreenRect[_SYMMETRY>0 ? (REVCGmaxnumberQ >> 1) : REVCGmaxnumberQ];
+	if (sparedatamgr) {
+		// left over from the engine's previous job
+		datamgr=sparedatamgr;
+		datamgr->rewind();
+		sparedatamgr=NULL;
+	} else datamgr=new ArrayDDByteManager;
 	graudensity=new uint8_t[SCREENWIDTH];
 	for(int32_t i=0;i<SCREENWIDTH;i++) graudensity[i]=100;
 	pcscr=NULL; 
@@ -1725,35 +3070,44 @@ Data5::Data5() {
 }
 
 Data5::~Data5() {
-	delete datamgr;
-	if (vgridYX) delete[] vgridYX;
-	if (revcgYX) delete[] revcgYX;
+	if ( (activeengine) && (!sparedatamgr) ) sparedatamgr=datamgr;
+	else delete datamgr;
+	if (revcgoffset) delete[] revcgoffset;
+	if (revcgparents) delete[] revcgparents;
+	if (revcgtovisit) delete[] revcgtovisit;
+	if (revcgcontainsgray) delete[] revcgcontainsgray;
+	if (revcgimage) delete[] revcgimage;
 	delete[] memgrau;
 	delete[] zeilen;
+	delete spanmgr;
+	delete[] rowbuffer;
+	delete[] spanbuffer;
 	if (pcscr) delete[] pcscr;
 	if (pcscrmgr) delete pcscrmgr;
 }
 
+// the 8 pixels in the low 16 bits of a, each one twice in a row.
+// Shifts and masks instead of pdep, so the compiler can vectorize
+// the blow-up loop
+static inline uint32_t double_pixels8(const uint32_t a) {
+	uint32_t x=a;
+	x=(x | (x << 8)) & 0x00FF00FF;
+	x=(x | (x << 4)) & 0x0F0F0F0F;
+	x=(x | (x << 2)) & 0x33333333;
+	
+	return x | (x << 2);
+}
+
 // one pixel transforming into a 2x2 grid, gray or gray-potentially-white will both
 // be set to gray. 
 // works here on a 32bit-integer, hence 16 consecutive bits directly
 void copy_pixel_to_2x2grid(const uint32_t q,uint32_t* erg) {
-	int32_t eidx=0;
-	int32_t zbit=0;
-	erg[0]=erg[1]=0;
+	// potw (both bits set) to gray (none set) in all lanes at once
+	const uint32_t potw=q & (q >> 1) & LANES_LOWBIT;
+	const uint32_t w=q & ~(potw | (potw << 1));
 	
-	for(int32_t qbit=0;qbit<32;qbit+=2) {
-		uint32_t w=((q >> qbit) & 0b11);
-		if (w == SQUARE_GRAY_POTENTIALLY_WHITE) w=SQUARE_GRAY;
-		erg[eidx] |= (w << zbit);
-		zbit += 2;
-		erg[eidx] |= (w << zbit);
-		zbit += 2;
-		if (zbit >= 32) {
-			zbit=0;
-			eidx=1;
-		}
-	} // qbit
+	erg[0]=double_pixels8(w & 0xFFFF);
+	erg[1]=double_pixels8(w >> 16);
 }
 
 static inline int32_t scrcoord_as_lowerleft(const NTYP& a) {
@@ -1793,6 +3147,23 @@ static inline int32_t scrcoord_as_lowerleft(const NTYP& a) {
 	if (w >= SCREENWIDTH) return (SCREENWIDTH-1);
 	return w;
 	#endif
+
+	#ifdef _DD
+	if (a <= COMPLETE0) return 0;
+	if (a >= COMPLETE1) return (SCREENWIDTH-1);
+	// scalePixelPerRange is a power of 2, the product is exact
+	w=(int)floorDD( (a - COMPLETE0) * scalePixelPerRange );
+	if (w >= SCREENWIDTH) return (SCREENWIDTH-1);
+	return w;
+	#endif
+
+	#ifdef _FIXPOINT
+	if (a <= COMPLETE0) return 0;
+	if (a >= COMPLETE1) return (SCREENWIDTH-1);
+	w=(int)floorFX( (a - COMPLETE0) * scalePixelPerRange );
+	if (w >= SCREENWIDTH) return (SCREENWIDTH-1);
+	return w;
+	#endif
 	
 	#ifdef _FPA
 	if (FPA_vgl(a,COMPLETE0) <= 0) return 0;
@@ -1809,7 +3180,7 @@ static inline int32_t scrcoord_as_lowerleft(const NTYP& a) {
 		(wfl > (int64_t)UINT32MAX)
 	) {
 		printf("Implementation error. FPA. out-of-range floor scrcoord %I64d\n",wfl);
-		exit(99);
+		fatal_exit(99);
 	}
 	if (wfl >= SCREENWIDTH) return (SCREENWIDTH-1);
 	
@@ -1829,7 +3200,7 @@ static inline int32_t scrcoord_as_lowerleft(const NTYP& a) {
 	#endif
 	
 	LOGMSG("Implementation error. scrcoord_as_lower_left.\n");
-	exit(99);
+	fatal_exit(99);
 }
 
 static inline int32_t scrcoord_as_lowerleft_double(const double& a) {
@@ -1927,6 +3298,14 @@ void precomputeYdep_z2c(
 	Z2CPRECOMPUTEY(minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z2CPRECOMPUTEY(minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z2CPRECOMPUTEY(minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	Z2CPRECOMPUTEY(minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -1966,6 +3345,14 @@ void precomputeXdep_z2c(
 	Z2CPRECOMPUTEX(minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z2CPRECOMPUTEX(minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z2CPRECOMPUTEX(minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	Z2CPRECOMPUTEX(minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -2017,6 +3404,14 @@ void getBoundingBoxfA_z2c_helper(
 	#ifdef _F107
 	Z2CHELPER(minimaxF107AB,minimaxF107ABCD);
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z2CHELPER(minimaxFXAB,minimaxFXABCD);
+	#endif
+	
+	#ifdef _DD
+	Z2CHELPER(minimaxDDAB,minimaxDDABCD);
+	#endif
 
 	#ifdef _F161
 	Z2CHELPER(minimaxF161AB,minimaxF161ABCD);
@@ -2172,6 +3567,14 @@ void getBoundingBoxfA_2itz2c_helper(
 	_2ITZ2CHELPER(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	_2ITZ2CHELPER(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	_2ITZ2CHELPER(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	_2ITZ2CHELPER(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -2349,6 +3752,14 @@ void precomputeXdep_2itz2c(
 	_2ITZ2CPRECOMPUTEX(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	_2ITZ2CPRECOMPUTEX(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	_2ITZ2CPRECOMPUTEX(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	_2ITZ2CPRECOMPUTEX(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -2427,6 +3838,14 @@ void precomputeYdep_2itz2c(
 	_2ITZ2CPRECOMPUTEY(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	_2ITZ2CPRECOMPUTEY(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	_2ITZ2CPRECOMPUTEY(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	_2ITZ2CPRECOMPUTEY(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -2515,6 +3934,14 @@ void getBoundingBoxfA_z3azc_helper(
 	Z3AZCHELPER(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z3AZCHELPER(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z3AZCHELPER(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	Z3AZCHELPER(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -2631,6 +4058,14 @@ void precomputeXdep_z3azc(
 	Z3AZCPRECOMPUTEX(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z3AZCPRECOMPUTEX(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z3AZCPRECOMPUTEX(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	Z3AZCPRECOMPUTEX(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -2703,6 +4138,14 @@ void precomputeYdep_z3azc(
 	Z3AZCPRECOMPUTEY(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z3AZCPRECOMPUTEY(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z3AZCPRECOMPUTEY(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	Z3AZCPRECOMPUTEY(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -2850,6 +4293,14 @@ void precomputeYdep_z4azc(
 	Z4AZCPRECOMPUTEY(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z4AZCPRECOMPUTEY(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z4AZCPRECOMPUTEY(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	Z4AZCPRECOMPUTEY(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -2915,6 +4366,14 @@ void precomputeXdep_z4azc(
 	Z4AZCPRECOMPUTEX(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z4AZCPRECOMPUTEX(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z4AZCPRECOMPUTEX(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	Z4AZCPRECOMPUTEX(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -2941,6 +4400,14 @@ void getBoundingBoxfA_z4azc_helper(
 	#ifdef _F107
 	Z4AZCHELPER(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z4AZCHELPER(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z4AZCHELPER(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
 
 	#ifdef _F161
 	Z4AZCHELPER(NTYP,minimaxF161AB,minimaxF161ABCD)
@@ -3126,8 +4593,16 @@ void getBoundingBoxfA_z5azc_helper(
 	#ifdef _F107
 	Z5AZCHELPER(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
-
-	#ifdef _F161
+	
+	#ifdef _FIXPOINT
+	Z5AZCHELPER(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z5AZCHELPER(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+
+	#ifdef _F161
 	Z5AZCHELPER(NTYP,minimaxF161AB,minimaxF161ABCD)
 	#endif
 
@@ -3268,6 +4743,14 @@ void precomputeYdep_z5azc(
 	Z5AZCPRECOMPUTEY(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z5AZCPRECOMPUTEY(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z5AZCPRECOMPUTEY(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	Z5AZCPRECOMPUTEY(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -3350,6 +4833,14 @@ void precomputeXdep_z5azc(
 	Z5AZCPRECOMPUTEX(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z5AZCPRECOMPUTEX(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z5AZCPRECOMPUTEX(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _QUADMATH
 	Z5AZCPRECOMPUTEX(NTYP,minimaxQDAB,minimaxQDABCD)
 	#endif
@@ -3477,6 +4968,14 @@ void getBoundingBoxfA_z6azc_helper(
 	#ifdef _F107
 	Z6AZCHELPER(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z6AZCHELPER(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z6AZCHELPER(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
 
 	#ifdef _F161
 	Z6AZCHELPER(NTYP,minimaxF161AB,minimaxF161ABCD)
@@ -3656,6 +5155,14 @@ void precomputeYdep_z6azc(
 	#ifdef _F107
 	Z6AZCPRECOMPUTEY(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z6AZCPRECOMPUTEY(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z6AZCPRECOMPUTEY(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
 
 	#ifdef _F161
 	Z6AZCPRECOMPUTEY(NTYP,minimaxF161AB,minimaxF161ABCD)
@@ -3742,6 +5249,14 @@ void precomputeXdep_z6azc(
 	#ifdef _F107
 	Z6AZCPRECOMPUTEX(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z6AZCPRECOMPUTEX(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z6AZCPRECOMPUTEX(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
 
 	#ifdef _F161
 	Z6AZCPRECOMPUTEX(NTYP,minimaxF161AB,minimaxF161ABCD)
@@ -3823,6 +5338,14 @@ void precomputeXdep_z7azc(
 	#ifdef _F107
 	Z7AZCPRECOMPUTEX(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z7AZCPRECOMPUTEX(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z7AZCPRECOMPUTEX(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
 
 	#ifdef _DOUBLE
 	Z7AZCPRECOMPUTEX(NTYP,minimaxdAB,minimaxdABCD)
@@ -3904,6 +5427,14 @@ void precomputeYdep_z7azc(
 	#ifdef _F107
 	Z7AZCPRECOMPUTEY(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z7AZCPRECOMPUTEY(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z7AZCPRECOMPUTEY(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
 
 	#ifdef _DOUBLE
 	Z7AZCPRECOMPUTEY(NTYP,minimaxdAB,minimaxdABCD)
@@ -4008,6 +5539,14 @@ void getBoundingBoxfA_z7azc_helper(
 	#ifdef _F107
 	Z7AZCHELPER(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z7AZCHELPER(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z7AZCHELPER(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
 
 	#ifdef _DOUBLE
 	Z7AZCHELPER(NTYP,minimaxdAB,minimaxdABCD)
@@ -4233,6 +5772,14 @@ void getBoundingBoxfA_z8azc_helper(
 	Z8AZCHELPER(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
 	
+	#ifdef _FIXPOINT
+	Z8AZCHELPER(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z8AZCHELPER(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
+	
 	#ifdef _F161
 	Z8AZCHELPER(NTYP,minimaxF161AB,minimaxF161ABCD)
 	#endif
@@ -4402,6 +5949,14 @@ void precomputeYdep_z8azc(
 	#ifdef _F107
 	Z8AZCPRECOMPUTEY(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z8AZCPRECOMPUTEY(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z8AZCPRECOMPUTEY(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
 
 	#ifdef _F161
 	Z8AZCPRECOMPUTEY(NTYP,minimaxF161AB,minimaxF107ABCD)
@@ -4420,7 +5975,7 @@ void precomputeYdep_z8azc(
 	#endif
 	
 	LOGMSG("Missing implementation. z8azc precompute Ydep helper\n");
-	exit(99);
+	fatal_exit(99);
 }
 
 #define Z8AZCPRECOMPUTEX_VARLIST(NUMTYP,MINMAX2,MINMAX4,ARE,AIM,C0RE,C1RE,C0IM,C1IM) \
@@ -4495,6 +6050,14 @@ void precomputeXdep_z8azc(
 	#ifdef _F107
 	Z8AZCPRECOMPUTEX(NTYP,minimaxF107AB,minimaxF107ABCD)
 	#endif
+	
+	#ifdef _FIXPOINT
+	Z8AZCPRECOMPUTEX(NTYP,minimaxFXAB,minimaxFXABCD)
+	#endif
+	
+	#ifdef _DD
+	Z8AZCPRECOMPUTEX(NTYP,minimaxDDAB,minimaxDDABCD)
+	#endif
 
 	#ifdef _F161
 	Z8AZCPRECOMPUTEX(NTYP,minimaxF161AB,minimaxF161ABCD)
@@ -4513,7 +6076,7 @@ void precomputeXdep_z8azc(
 	#endif
 	
 	LOGMSG("Missing implementation. z8azc precompute Xdep helper\n");
-	exit(99);
+	fatal_exit(99);
 }
 
 void precomputeXdep_z8azc_double(
@@ -4564,52 +6127,44 @@ void write4(FILE *f,const uint8_t a,const uint8_t b,const uint8_t c,const uint8_
 }
 
 void construct_static_reverse_cellgraph(void) {
-	for(int32_t i=0;i<REVCGmaxnumberQ;i++) {
-		data5->revcgYX[i].howmany=0;
-		data5->revcgYX[i].memused=0;
-		data5->revcgYX[i].parent=NULL;
-		
-		data5->revcgYX[i].containsgray=0;
+	const int64_t OFFROW=REVCGmaxnumber+1;
+	for(int64_t i=0;i<(OFFROW*REVCGmaxnumber);i++) {
+		data5->revcgoffset[i]=0;
+	}
+	for(int32_t i=0;i<REVCGmaxnumber;i++) data5->revcgparents[i]=NULL;
+	for(int32_t i=0;i<=(REVCGmaxnumberQ >> 6);i++) {
+		data5->revcgcontainsgray[i]=0;
+		data5->revcgtovisit[i]=0;
 	}
 	
 	// check which revcg vertices may contains gray
 	int32_t parentx,parenty;
 	for(int32_t y=0;y<SCREENWIDTH;y+=REVCGBLOCKWIDTH) {
 		parenty=(y >> REVCGBITS);
-		int32_t poffsety=(int64_t)parenty*REVCGmaxnumber;
+		int64_t poffsety=(int64_t)parenty*REVCGmaxnumber;
 
 		for(int32_t x=0;x<SCREENWIDTH;x+=REVCGBLOCKWIDTH) {
 			parentx=(x >> REVCGBITS);
 			
 			// do the coordinates of that revcg vertex
-			// lie in memgrau.g0..g1 of row y
+			// lie in a gray span of row y
 			int hasgray=0;
 			
 			for(int y2=y;y2<(y+REVCGBLOCKWIDTH);y2++) {
 				if (!data5->zeilen[y2]) continue;
 			
 				// revcg block starting at x must OVERLAP with
-				// gray in row, but not necessarily be contained
+				// a span in the row, but not necessarily be contained
 				// fully within
-				// [x..x+REVCGBLOCKWIDTH-1] geschniten [g0..g1]
-				int32_t xe=x+REVCGBLOCKWIDTH-1;
-				
-				if (
-					(xe < data5->memgrau[y2].g0) ||
-					(x > data5->memgrau[y2].g1)
-				) {
-					// not overlapping
-				} 
-				else {
+				if (data5->memgrau[y2].overlaps(x,x+REVCGBLOCKWIDTH-1) > 0) {
 					hasgray=1;
 					break;
 				}
 			}
 			
 			if (hasgray>0) {
-				data5->revcgYX[poffsety+parentx].containsgray=1;
-			} else {
-				data5->revcgYX[poffsety+parentx].containsgray=0;
+				int64_t tileidx=poffsety+parentx;
+				REVCGSETBIT(data5->revcgcontainsgray,tileidx)
 			}
 		}
 	} // y
@@ -4622,9 +6177,38 @@ void construct_static_reverse_cellgraph(void) {
 		// first pass: calculuate how many are nedded per square
 		// 2nd pass: build cell graph as array allocating exact amount of memory
 		if (dl==1) printf("\ncounting parents ...");
-		else printf("\nsetting parents to squares ... ");
+		else {
+			printf("\nsetting parents to squares ... ");
+			
+			// counts to row-relative offsets, the offset of a tile
+			// is its write cursor in the 2nd pass
+			const int64_t MAXPERROW=CHUNKSIZE / sizeof(Parent);
+			for(int32_t by=0;by<REVCGmaxnumber;by++) {
+				uint32_t* off=&data5->revcgoffset[by*OFFROW];
+				int64_t sum=0;
+				for(int32_t bx=0;bx<REVCGmaxnumber;bx++) {
+					int64_t cnt=off[bx];
+					off[bx]=sum;
+					sum += cnt;
+				}
+				off[REVCGmaxnumber]=sum;
+				if (sum > MAXPERROW) {
+					LOGMSG("Error. Reverse cell graph row exceeds memory chunk.\n");
+					fatal_exit(99);
+				}
+				if (sum > 0) {
+					data5->revcgparents[by]=parentmgr->getParentSpace(sum);
+					if (!data5->revcgparents[by]) {
+						LOGMSG("Memory failure for parent.\n");
+						fatal_exit(99);
+					}
+				}
+			}
+		}
 		
 		for(int32_t y=0;y<SCREENWIDTH;y+=REVCGBLOCKWIDTH) {
+			// only lower half tiles are visited and can be parents
+			if ( (_SYMMETRY>0) && (y >= (SCREENWIDTH >> 1)) ) break;
 			parenty=(y >> REVCGBITS);
 			#ifdef _FPA
 			A.y0=A.y1;
@@ -4646,8 +6230,11 @@ void construct_static_reverse_cellgraph(void) {
 				#endif
 			
 				// no use of helper object here
-				// as size of A16 is NOT scaleRangePerPixel
-				getBoundingBoxfA(A,bbxfA);
+				// as size of A16 is NOT scaleRangePerPixel.
+				// interval extension, not the centred form: a pixel's
+				// box must lie in its tile's box, which only the
+				// inclusion-isotonic extension guarantees
+				getBoundingBoxfA_ia(A,bbxfA);
 			
 				if (SQUARE_LIES_ENTIRELY_IN_SPECEXT(bbxfA) > 0) {
 					continue;
@@ -4660,19 +6247,26 @@ void construct_static_reverse_cellgraph(void) {
 				scr.x1=scrcoord_as_lowerleft(bbxfA.x1);
 				scr.y0=scrcoord_as_lowerleft(bbxfA.y0);
 				scr.y1=scrcoord_as_lowerleft(bbxfA.y1);
+				if (dl==1) {
+					data5->revcgimage[(int64_t)parenty*REVCGmaxnumber+parentx]=scr;
+				}
 				
 				scr.x0 >>= REVCGBITS;
 				scr.x1 >>= REVCGBITS;
 				scr.y0 >>= REVCGBITS;
 				scr.y1 >>= REVCGBITS;
 
+				// every parent tile is handled exactly once, so the
+				// parent list of a tile contains no duplicates
 				if (dl==1) {
 					// just counting
 					for(int32_t by=scr.y0;by<=scr.y1;by++) {
 						int64_t yoffset=(int64_t)by*REVCGmaxnumber;
+						uint32_t* off=&data5->revcgoffset[by*OFFROW];
 						for(int32_t bx=scr.x0;bx<=scr.x1;bx++) {
-							if (data5->revcgYX[yoffset+bx].containsgray>0) {
-								data5->revcgYX[yoffset+bx].memused++;
+							int64_t tileidx=yoffset+bx;
+							if (REVCGGETBIT(data5->revcgcontainsgray,tileidx)) {
+								off[bx]++;
 							}
 						}
 					} // by
@@ -4680,11 +6274,16 @@ void construct_static_reverse_cellgraph(void) {
 					// setting parents to square
 					for(int32_t by=scr.y0;by<=scr.y1;by++) {
 						int64_t yoffset=(int64_t)by*REVCGmaxnumber;
+						uint32_t* off=&data5->revcgoffset[by*OFFROW];
+						Parent* par=data5->revcgparents[by];
 						for(int32_t bx=scr.x0;bx<=scr.x1;bx++) {
 							// if the revcg vertex by,bx contains gray
 							// => a parent needs to be set
-							if (data5->revcgYX[yoffset+bx].containsgray>0) {
-								data5->revcgYX[yoffset+bx].addParent(parentx,parenty);
+							int64_t tileidx=yoffset+bx;
+							if (REVCGGETBIT(data5->revcgcontainsgray,tileidx)) {
+								par[off[bx]].BX=parentx;
+								par[off[bx]].BY=parenty;
+								off[bx]++;
 							}
 						}
 					} // by
@@ -4692,6 +6291,14 @@ void construct_static_reverse_cellgraph(void) {
 			} // x
 		} // y
 	} // passes
+	
+	// write cursors now point to the next tile's start:
+	// shift back by one tile
+	for(int32_t by=0;by<REVCGmaxnumber;by++) {
+		uint32_t* off=&data5->revcgoffset[by*OFFROW];
+		for(int32_t bx=REVCGmaxnumber-1;bx>0;bx--) off[bx]=off[bx-1];
+		off[0]=0;
+	}
 }
 
 void compute(void) {
@@ -4713,21 +6320,21 @@ void compute(void) {
 	if (_PROPAGATEPOTW>0) {
 		if (_PROPAGATEDEF>0) {
 			printf("saving raw data ... ");
-			data5->saveRaw("_temp");
+			data5->saveRaw(TEMPFN);
 			printf("done\n");
 		}
 		propagate_potw();
 		printf("\nsearching for interior cells ... ");
-		int32_t res=color_changeS32(
-			SQUARE_GRAY,
-			SQUARE_BLACK,
-			SQUARE_GRAY_16_CONSECUTIVE,
-			SQUARE_BLACK_16_CONSECUTIVE
-		);
+		int32_t res=color_changeS32(SQUARE_GRAY,SQUARE_BLACK);
 		if (res>0) interiorpresent=1;
 	} else {
 		printf("\nskipping interior coloring (potw not propagated)\n");
 	}
+	
+	if ( (_CENTREDDEGREE>0) && (centredareaia > 0.0) ) {
+		LOGMSG2("\ncentred form: average bounding box area %.1lf%% of the interval extension\n",
+			100.0*centredarea/centredareaia);
+	}
 }
 
 void find_special_exterior_hitting_squares(void) {
@@ -4740,10 +6347,7 @@ void find_special_exterior_hitting_squares(void) {
 	
 	// initialising gray enclosement per row
 	for(int32_t y=0;y<SCREENWIDTH;y++) {
-		data5->memgrau[y].g0=0;
-		data5->memgrau[y].g1=SCREENWIDTH-1;
-		data5->memgrau[y].mem0=0;
-		data5->memgrau[y].mem1=(SCREENWIDTH >> 4)-1;
+		data5->setRowFull(y);
 	}
 	
 	int32_t noch0=(SCREENWIDTH >> 4) >> 2;
@@ -4800,20 +6404,13 @@ void find_special_exterior_hitting_squares(void) {
 		if (gray0 < encgrayx0) encgrayx0=gray0;
 		if (gray1 > encgrayx1) encgrayx1=gray1;
 		
-		// adjusting gray enclosement per row
+		// gray density per row, the spans are tightened by the caller
 		for(int32_t yy=y16;yy<(y16+16);yy++) {
-			data5->memgrau[yy].g0=gray0;
-			data5->memgrau[yy].g1=gray1;
 			if (gray1 >= gray0) {
 				data5->graudensity[yy]=(uint8_t)(100.0*(double)(gray1-gray0+1)/(double)SCREENWIDTH);
 			}  else {
 				data5->graudensity[yy]=0;
 			}
-
-			// whole row was allocated outside in calling routine
-			// => mem spans the entire pixel coordinate range
-			data5->memgrau[yy].mem0=0;
-			data5->memgrau[yy].mem1=(SCREENWIDTH >> 4)-1;
 		} // yy
 	} // y16
 	
@@ -4868,23 +6465,437 @@ void find_special_exterior_hitting_squares(void) {
 	
 	if (touches>0) {
 		LOGMSG("\n\nGray region touches image border which is not possible in the current implementation.\nIncreased RANGE value is recommended.\n");
-		exit(99);
+		fatal_exit(99);
+	}
+}
+
+// classifies those pixels of a 32bit integer whose low color bit
+// is set in the lane mask m5 and returns the colors found as
+// RECTSCAN flags
+static inline int32_t classify_word(const uint32_t w,const uint32_t m5) {
+	const uint32_t lo=w & LANES_LOWBIT;
+	const uint32_t hi=(w >> 1) & LANES_LOWBIT;
+	int32_t erg=0;
+	
+	if ( (~(lo | hi)) & m5) erg |= RECTSCAN_GRAY;
+	if ( (lo & ~hi) & m5) erg |= RECTSCAN_WHITE;
+	if ( (hi & ~lo) & m5) erg |= RECTSCAN_BLACK;
+	if ( (lo & hi) & m5) erg |= RECTSCAN_GRAYPOTW;
+	
+	return erg;
+}
+
+// lane mask of the pixels b0..b1 (0..15) in a 32bit integer
+static inline uint32_t lanemask(const int32_t b0,const int32_t b1) {
+	uint64_t m=( ((uint64_t)1 << ((b1+1) << 1)) - 1 );
+	m &= ~( ((uint64_t)1 << (b0 << 1)) - 1 );
+	
+	return (uint32_t)m & LANES_LOWBIT;
+}
+
+#ifdef _RECTSCANAVX2
+// 8 32bit integers per instruction, all 16 pixels of each are classified
+static inline int32_t classify_words_avx2(const uint32_t* aw,const int32_t anz) {
+	const __m256i lowbit=_mm256_set1_epi32((int)LANES_LOWBIT);
+	__m256i accgray=_mm256_setzero_si256();
+	__m256i accwhite=_mm256_setzero_si256();
+	__m256i accblack=_mm256_setzero_si256();
+	__m256i accpotw=_mm256_setzero_si256();
+	
+	for(int32_t i=0;i<anz;i+=8) {
+		__m256i v=_mm256_loadu_si256((const __m256i*)&aw[i]);
+		__m256i lo=_mm256_and_si256(v,lowbit);
+		__m256i hi=_mm256_and_si256(_mm256_srli_epi32(v,1),lowbit);
+		accgray=_mm256_or_si256(accgray,_mm256_andnot_si256(_mm256_or_si256(lo,hi),lowbit));
+		accwhite=_mm256_or_si256(accwhite,_mm256_andnot_si256(hi,lo));
+		accblack=_mm256_or_si256(accblack,_mm256_andnot_si256(lo,hi));
+		accpotw=_mm256_or_si256(accpotw,_mm256_and_si256(lo,hi));
+	}
+	
+	int32_t erg=0;
+	if (!_mm256_testz_si256(accgray,accgray)) erg |= RECTSCAN_GRAY;
+	if (!_mm256_testz_si256(accwhite,accwhite)) erg |= RECTSCAN_WHITE;
+	if (!_mm256_testz_si256(accblack,accblack)) erg |= RECTSCAN_BLACK;
+	if (!_mm256_testz_si256(accpotw,accpotw)) erg |= RECTSCAN_GRAYPOTW;
+	
+	return erg;
+}
+#endif
+
+#ifdef _RECTSCANSSE2
+static inline int32_t nonzero_sse2(const __m128i a) {
+	return (_mm_movemask_epi8(_mm_cmpeq_epi8(a,_mm_setzero_si128())) != 0xFFFF);
+}
+
+// 4 32bit integers per instruction, all 16 pixels of each are classified
+static inline int32_t classify_words_sse2(const uint32_t* aw,const int32_t anz) {
+	const __m128i lowbit=_mm_set1_epi32((int)LANES_LOWBIT);
+	__m128i accgray=_mm_setzero_si128();
+	__m128i accwhite=_mm_setzero_si128();
+	__m128i accblack=_mm_setzero_si128();
+	__m128i accpotw=_mm_setzero_si128();
+	
+	for(int32_t i=0;i<anz;i+=4) {
+		__m128i v=_mm_loadu_si128((const __m128i*)&aw[i]);
+		__m128i lo=_mm_and_si128(v,lowbit);
+		__m128i hi=_mm_and_si128(_mm_srli_epi32(v,1),lowbit);
+		accgray=_mm_or_si128(accgray,_mm_andnot_si128(_mm_or_si128(lo,hi),lowbit));
+		accwhite=_mm_or_si128(accwhite,_mm_andnot_si128(hi,lo));
+		accblack=_mm_or_si128(accblack,_mm_andnot_si128(lo,hi));
+		accpotw=_mm_or_si128(accpotw,_mm_and_si128(lo,hi));
+	}
+	
+	int32_t erg=0;
+	if (nonzero_sse2(accgray)) erg |= RECTSCAN_GRAY;
+	if (nonzero_sse2(accwhite)) erg |= RECTSCAN_WHITE;
+	if (nonzero_sse2(accblack)) erg |= RECTSCAN_BLACK;
+	if (nonzero_sse2(accpotw)) erg |= RECTSCAN_GRAYPOTW;
+	
+	return erg;
+}
+#endif
+
+// scans all pixels of the screen rectangle and returns the colors
+// found as RECTSCAN flags. Every 32bit integer is loaded once, pixels
+// outside [x0..x1] are masked off. The scan stops as soon as one of the
+// colors in astopany or all colors in astopall (if not 0) were found
+static int32_t scan_rect_colors_rows(
+	const ScreenRect& scr,
+	const int32_t astopany,const int32_t astopall
+) {
+	int32_t found=0;
+	const int32_t m0=scr.x0 >> 4;
+	const int32_t m1=scr.x1 >> 4;
+	const uint32_t firstmask=lanemask(scr.x0 & 0b1111,15);
+	const uint32_t lastmask=lanemask(0,scr.x1 & 0b1111);
+	
+	#define RECTSCANSTOP \
+	(\
+		( (found & astopany) != 0 ) ||\
+		( (astopall != 0) && ( (found & astopall) == astopall) )\
+	)
+	
+	for(int32_t ty=scr.y0;ty<=scr.y1;ty++) {
+		const Gray_in_row* mg=&data5->memgrau[ty];
+		// integers outside the row's spans are white, or black
+		// in the gap before a span marked so
+		int32_t next=m0;
+		int32_t sp=(mg->anzspans > 0) ? mg->firstSpan(m0) : 0;
+		
+		for(;sp<mg->anzspans;sp++) {
+			const int32_t rmem0=mg->spans[sp].mem0;
+			const int32_t rmem1=mg->spans[sp].mem1;
+			if (rmem1 < m0) continue;
+			if (rmem0 > m1) break;
+			
+			if (rmem0 > next) {
+				found |= (mg->spans[sp].blackbefore > 0) ? RECTSCAN_BLACK : RECTSCAN_WHITE;
+			}
+		
+			const int32_t a=maximumI(m0,rmem0);
+			const int32_t b=minimumI(m1,rmem1);
+			next=b+1;
+			const uint32_t* row=&data5->zeilen[ty][mg->spans[sp].offset+a-rmem0];
+			
+			if (a == b) {
+				uint32_t m=LANES_LOWBIT;
+				if (a == m0) m &= firstmask;
+				if (a == m1) m &= lastmask;
+				found |= classify_word(row[0],m);
+			} else {
+				// partial integers at both ends
+				int32_t i0=0,i1=b-a;
+				if (a == m0) {
+					found |= classify_word(row[0],firstmask);
+					i0++;
+				}
+				if (b == m1) {
+					found |= classify_word(row[i1],lastmask);
+					i1--;
+				}
+				
+				// fully covered integers in between
+				#ifdef _RECTSCANAVX2
+				int32_t vanz=((i1-i0+1) >> 3) << 3;
+				if (vanz > 0) {
+					found |= classify_words_avx2(&row[i0],vanz);
+					i0 += vanz;
+				}
+				#endif
+				#ifdef _RECTSCANSSE2
+				int32_t vanz=((i1-i0+1) >> 2) << 2;
+				if (vanz > 0) {
+					found |= classify_words_sse2(&row[i0],vanz);
+					i0 += vanz;
+				}
+				#endif
+				for(int32_t i=i0;i<=i1;i++) {
+					found |= classify_word(row[i],LANES_LOWBIT);
+				}
+			}
+		} // sp
+		
+		if (next <= m1) {
+			if ( (sp < mg->anzspans) && (mg->spans[sp].blackbefore > 0) ) found |= RECTSCAN_BLACK;
+			else found |= RECTSCAN_WHITE;
+		}
+		
+		if (RECTSCANSTOP) return found;
+	} // ty
+	
+	#undef RECTSCANSTOP
+	
+	return found;
+}
+
+WindowOracle::WindowOracle() {
+	width=shift=0;
+	rowstart=rowlen=NULL;
+	rowoffset=NULL;
+	words=NULL;
+	x0=x1=y0=y1=0;
+	cx0=cx1=cy0=cy1=0;
+}
+
+WindowOracle::~WindowOracle() {
+	if (rowstart) delete[] rowstart;
+	if (rowlen) delete[] rowlen;
+	if (rowoffset) delete[] rowoffset;
+	if (words) delete[] words;
+}
+
+// reads the raw image afn whose pixels are 2^ashift pixels of the
+// current level wide. Returns 0 if it is missing or of another width
+int8_t WindowOracle::read(const char* afn,const int32_t ashift) {
+	FILE *f=fopen(afn,"rb");
+	if (!f) return 0;
+	
+	DDBYTE savedlen;
+	fread(&savedlen,sizeof(savedlen),1,f);
+	if (
+		(ashift < 1) ||
+		((int32_t)savedlen != (SCREENWIDTH >> ashift))
+	) {
+		fclose(f);
+		return 0;
+	}
+	width=savedlen;
+	shift=ashift;
+	rowstart=new int32_t[width];
+	rowlen=new int32_t[width];
+	rowoffset=new int64_t[width+1];
+	
+	// first pass: row lengths only
+	rowoffset[0]=0;
+	for(int32_t y=0;y<width;y++) {
+		fread(&rowstart[y],1,sizeof(int32_t),f);
+		fread(&rowlen[y],1,sizeof(int32_t),f);
+		if (rowlen[y] < 0) rowlen[y]=0;
+		fseek(f,(long)rowlen[y]*sizeof(DDBYTE),SEEK_CUR);
+		rowoffset[y+1]=rowoffset[y]+rowlen[y];
+	}
+	
+	words=new DDBYTE[rowoffset[width]+1];
+	fseek(f,sizeof(savedlen),SEEK_SET);
+	cx0=cy0=width;
+	cx1=cy1=-1;
+	for(int32_t y=0;y<width;y++) {
+		int32_t start,laenge;
+		fread(&start,1,sizeof(start),f);
+		fread(&laenge,1,sizeof(laenge),f);
+		if (rowlen[y] <= 0) continue;
+		DDBYTE* w=&words[rowoffset[y]];
+		fread(w,rowlen[y],sizeof(DDBYTE),f);
+		for(int32_t i=0;i<rowlen[y];i++) {
+			if (w[i] == SQUARE_WHITE_16_CONSECUTIVE) continue;
+			const int32_t x=(rowstart[y]+i) << 4;
+			if (x < cx0) cx0=x;
+			if ( (x+15) > cx1) cx1=x+15;
+			if (y < cy0) cy0=y;
+			if (y > cy1) cy1=y;
+		}
+	} // y
+	
+	fclose(f);
+	
+	if (cx1 < 0) {
+		// all white
+		cx0=cx1=cy0=cy1=0;
 	}
+	
+	return 1;
+}
+
+// window of the plane rounded outwards to whole integers and whole
+// coarse pixels, so every pixel lies either in the window or in a coarse
+// pixel completely outside it
+void WindowOracle::setWindow(
+	const double are0,const double are1,
+	const double aim0,const double aim1
+) {
+	int32_t unit=(1 << shift);
+	if (unit < 16) unit=16;
+	
+	#define SNAPDOWN(VAL) \
+		(int32_t)floor( ((VAL)-RANGE0)*scalePixelPerRange_double / unit )*unit
+	#define SNAPUP(VAL) \
+		(int32_t)ceil( ((VAL)-RANGE0)*scalePixelPerRange_double / unit )*unit - 1
+	
+	x0=SNAPDOWN(are0);
+	x1=SNAPUP(are1);
+	y0=SNAPDOWN(aim0);
+	y1=SNAPUP(aim1);
+	
+	#undef SNAPDOWN
+	#undef SNAPUP
+	
+	if (x0 < 0) x0=0;
+	if (y0 < 0) y0=0;
+	if (x1 > (SCREENWIDTH-1)) x1=SCREENWIDTH-1;
+	if (y1 > (SCREENWIDTH-1)) y1=SCREENWIDTH-1;
+	if (x1 < x0) x1=x0+unit-1;
+	if (y1 < y0) y1=y0+unit-1;
+}
+
+// color of coarse pixel (ax,ay)
+int32_t WindowOracle::colorAt(const int32_t ax,const int32_t ay) {
+	const int32_t mem=(ax >> 4)-rowstart[ay];
+	if ( (mem < 0) || (mem >= rowlen[ay]) ) return SQUARE_WHITE;
+	
+	return (words[rowoffset[ay]+mem] >> ((ax & 0b1111) << 1)) & 0b11;
+}
+
+// adds the colors of the coarse pixels covering the screen rectangle
+// to afound, coarse gray is reported as potentially white
+int32_t WindowOracle::scanCoarse(
+	const ScreenRect& scr,
+	const int32_t astopany,const int32_t astopall,
+	int32_t afound
+) {
+	const int32_t sx0=scr.x0 >> shift;
+	const int32_t sx1=scr.x1 >> shift;
+	const int32_t m0=sx0 >> 4;
+	const int32_t m1=sx1 >> 4;
+	const uint32_t firstmask=lanemask(sx0 & 0b1111,15);
+	const uint32_t lastmask=lanemask(0,sx1 & 0b1111);
+	int32_t found=0;
+	
+	for(int32_t cy=(scr.y0 >> shift);cy<=(scr.y1 >> shift);cy++) {
+		const int32_t r0=rowstart[cy];
+		const int32_t r1=r0+rowlen[cy]-1;
+		if ( (r0 > m0) || (r1 < m1) ) found |= RECTSCAN_WHITE;
+		
+		const int32_t a=maximumI(m0,r0);
+		const int32_t b=minimumI(m1,r1);
+		const DDBYTE* w=&words[rowoffset[cy]];
+		for(int32_t i=a;i<=b;i++) {
+			uint32_t m=LANES_LOWBIT;
+			if (i == m0) m &= firstmask;
+			if (i == m1) m &= lastmask;
+			found |= classify_word(w[i-r0],m);
+		}
+		
+		if (found & RECTSCAN_GRAY) {
+			found=(found & ~RECTSCAN_GRAY) | RECTSCAN_GRAYPOTW;
+		}
+		afound |= found;
+		if (
+			( (afound & astopany) != 0 ) ||
+			( (astopall != 0) && ( (afound & astopall) == astopall) )
+		) break;
+	} // cy
+	
+	return afound;
+}
+
+// colors of the parts of the screen rectangle outside the window, the
+// part inside is returned in ainner (empty if x0>x1 or y0>y1)
+int32_t WindowOracle::scanOutside(
+	const ScreenRect& scr,
+	const int32_t astopany,const int32_t astopall,
+	ScreenRect& ainner
+) {
+	int32_t found=0;
+	ainner.x0=maximumI(scr.x0,x0);
+	ainner.x1=minimumI(scr.x1,x1);
+	ainner.y0=maximumI(scr.y0,y0);
+	ainner.y1=minimumI(scr.y1,y1);
+	
+	ScreenRect r=scr;
+	// rows below and above the window
+	if (scr.y0 < y0) {
+		r.y1=minimumI(scr.y1,y0-1);
+		found=scanCoarse(r,astopany,astopall,found);
+	}
+	if (scr.y1 > y1) {
+		r.y0=maximumI(scr.y0,y1+1);
+		r.y1=scr.y1;
+		found=scanCoarse(r,astopany,astopall,found);
+	}
+	if (ainner.y0 > ainner.y1) return found;
+	
+	// left and right of the window in its rows
+	r.y0=ainner.y0;
+	r.y1=ainner.y1;
+	if (scr.x0 < x0) {
+		r.x0=scr.x0;
+		r.x1=minimumI(scr.x1,x0-1);
+		found=scanCoarse(r,astopany,astopall,found);
+	}
+	if (scr.x1 > x1) {
+		r.x0=maximumI(scr.x0,x1+1);
+		r.x1=scr.x1;
+		found=scanCoarse(r,astopany,astopall,found);
+	}
+	
+	return found;
+}
+
+// RECTSCAN flags of the screen rectangle, see scan_rect_colors_rows. In
+// window mode the part outside the window is taken from the oracle
+static int32_t scan_rect_colors(
+	const ScreenRect& scr,
+	const int32_t astopany,const int32_t astopall
+) {
+	if (!windoworacle) return scan_rect_colors_rows(scr,astopany,astopall);
+	
+	ScreenRect inner;
+	int32_t found=windoworacle->scanOutside(scr,astopany,astopall,inner);
+	if (
+		( (found & astopany) != 0 ) ||
+		( (astopall != 0) && ( (found & astopall) == astopall) )
+	) return found;
+	if ( (inner.x0 > inner.x1) || (inner.y0 > inner.y1) ) return found;
+	
+	return found | scan_rect_colors_rows(inner,astopany,astopall);
+}
+
+// left edge of pixel ap
+static inline void set_plane_coord(NTYP& r,const int32_t ap) {
+	#ifdef _FPA
+	FPA tmp;
+	FPA_mul_ZAuvlong(tmp,scaleRangePerPixel,ap);
+	FPA_add_ZAB(r,tmp,COMPLETE0);
+	#else
+	r=ap*scaleRangePerPixel + COMPLETE0;
+	#endif
 }
 
 void propagate_definite(void) {
 	PlaneRect A,bbxfA;
 	ScreenRect scr;
-	int32_t noch0=((SCREENWIDTH >> REVCGBITS) >> 1);
+	int32_t noch0=(REVCGmaxnumberQ >> 3)+1;
 	int32_t noch=6;
 	int8_t changed=1;
+	int32_t passes=0;
+	RevCGOrder order;
 	int32_t lastsavetime=0;
 	int64_t checkclockat=ctrbbxfa+checkclockatbbxcount0;
 	
 	// mark every tile as to be visited
-	for(int32_t i=0;i<REVCGmaxnumberQ;i++) {
-		data5->revcgYX[i].tovisit=1;
-		data5->revcgYX[i].containsgray=1;
+	for(int32_t i=0;i<=(REVCGmaxnumberQ >> 6);i++) {
+		data5->revcgtovisit[i]=~(uint64_t)0;
+		data5->revcgcontainsgray[i]=~(uint64_t)0;
 	}
 	
 	changed=1;
@@ -4893,8 +6904,29 @@ void propagate_definite(void) {
 		changed=0;
 		printf("\npropagating definite color ... ");
 
-		for(int32_t y256=0,YBLOCK=0;y256<SCREENWIDTH;y256+=REVCGBLOCKWIDTH,YBLOCK++) {
-			int32_t yrevoffset=YBLOCK*REVCGmaxnumber;
+		// tile rows within the gray enclosement
+		int32_t row0=0,row1=-1;
+		for(int32_t YBLOCK=0;YBLOCK<REVCGmaxnumber;YBLOCK++) {
+			int32_t y256=YBLOCK << REVCGBITS;
+			if ( (y256+REVCGBLOCKWIDTH) < encgrayy0) continue;
+			if (y256 > encgrayy1) break;
+			// upper half mirrors the lower one
+			if ( (_SYMMETRY>0) && (y256 >= (SCREENWIDTH >> 1)) ) break;
+			if (row1 < row0) row0=YBLOCK;
+			row1=YBLOCK;
+		}
+		
+		order.start(_ORDER,passes,row0,row1);
+		passes++;
+		
+		int64_t tileidx;
+		while ( (tileidx=order.next()) >= 0) {
+			const int32_t YBLOCK=tileidx / REVCGmaxnumber;
+			const int32_t XBLOCK=tileidx-(int64_t)YBLOCK*REVCGmaxnumber;
+			const int32_t y256=YBLOCK << REVCGBITS;
+			const int32_t x256=XBLOCK << REVCGBITS;
+			const int32_t GLOBALBY=YBLOCK;
+			
 			if ( (--noch) <= 0) {
 				printf("%i ",SCREENWIDTH-y256);
 				noch=noch0;
@@ -4905,226 +6937,215 @@ void propagate_definite(void) {
 				int t2=clock();
 				if ((t2-lastsavetime) > CLOCKHOURSTOSAVE) {
 					printf("saving raw data ... ");
-					data5->saveRaw("_temp");
+					data5->saveRaw(TEMPFN);
 					printf("done\n");
 					lastsavetime=t2;
 				}
 			}
-		
-			// outside gray enclosement => jump out
-			if ( (y256+REVCGBLOCKWIDTH) < encgrayy0) continue;
-			if (y256 > encgrayy1) break;
-	
-			int32_t lastBX=-1; // last vertex set to VISITED-AGAIN
-			int32_t GLOBALBY=y256 >> REVCGBITS;
-			int32_t GLOBALBYOFFSET=GLOBALBY*REVCGmaxnumber;
+			
+			// block has now been checked
+			REVCGCLEARBIT(data5->revcgtovisit,tileidx)
 
-			for(int32_t x256=0,XBLOCK=0;x256<SCREENWIDTH;x256+=REVCGBLOCKWIDTH,XBLOCK++) {
-				if ( (data5->revcgYX[yrevoffset+XBLOCK].tovisit<=0) ) {
-					continue;
-				}
+			const int32_t Y256ENDE=y256+REVCGBLOCKWIDTH;
+		
+			// ATTN: even if bbxprecomputed
+			// A.y HAS TO BE calculated
+			// as it is INCREMENTED in every yloop
+			#ifdef _FPA
+			FPA_mul_ZAuvlong(A.y1,scaleRangePerPixel,y256);
+			FPA_add_ZAB(A.y1,A.y1,COMPLETE0);
+			#else
+			A.y1=y256*scaleRangePerPixel + COMPLETE0;
+			#endif
 			
-				// visit, but is there still gray
-				if (data5->revcgYX[yrevoffset+XBLOCK].containsgray<=0) {
-					continue;
-				}
-				
-				// block has now been checked
-				data5->revcgYX[yrevoffset+XBLOCK].tovisit=0;
-	
-				const int32_t Y256ENDE=y256+REVCGBLOCKWIDTH;
+			int8_t blockhasgray=0;
+			// pixels of the integers that changed in this tile
+			int32_t dirtyx0=SCREENWIDTH,dirtyx1=-1;
+			int32_t dirtyy0=SCREENWIDTH,dirtyy1=-1;
 			
-				// ATTN: even if bbxprecomputed
-				// A.y HAS TO BE calculated
-				// as it is INCREMENTED in every yloop
+			for(int32_t y=y256;y<Y256ENDE;y++) {
+				A.y0=A.y1;
 				#ifdef _FPA
-				FPA_mul_ZAuvlong(A.y1,scaleRangePerPixel,y256);
-				FPA_add_ZAB(A.y1,A.y1,COMPLETE0);
+				FPA_add_ZAB(A.y1,A.y0,scaleRangePerPixel);
 				#else
-				A.y1=y256*scaleRangePerPixel + COMPLETE0;
+				A.y1=A.y0+scaleRangePerPixel;
 				#endif
-				
-				int8_t blockhasgray=0;
-				
-				for(int32_t y=y256;y<Y256ENDE;y++) {
-					A.y0=A.y1;
-					#ifdef _FPA
-					FPA_add_ZAB(A.y1,A.y0,scaleRangePerPixel);
-					#else
-					A.y1=A.y0+scaleRangePerPixel;
-					#endif
 
-					int8_t bbxprecomputedrow=0;
-					if (data5->pcscr) {
-						if (data5->pcscr[y]) bbxprecomputedrow=1;
-					}
+				int8_t bbxprecomputedrow=0;
+				if (data5->pcscr) {
+					if (data5->pcscr[y]) bbxprecomputedrow=1;
+				}
 
-					const int32_t xanf=data5->memgrau[y].g0;
-					const int32_t xende=data5->memgrau[y].g1;
-					if (xende < xanf) continue;
+				// gray spans of that row outside of area 
+				// of this revcg vertex ?
+				if (data5->memgrau[y].overlaps(x256,x256+REVCGBLOCKWIDTH-1) <= 0) continue;
 			
-					// gray in that row lies outside of area 
-					// of this revcg vertex ?
-					if ( 
-						(x256 > xende) ||
-						( (x256+REVCGBLOCKWIDTH) < xanf) 
-					) continue;
-				
-					Helper* helperY=helperYdep->getHelper(y);
-					int32_t wmem=-1 + (x256 >> 4);
+				Helper* helperY=helperYdep->getHelper(y);
+				int32_t wmem=-1 + (x256 >> 4);
+	
+				for(int32_t x=x256;x<(x256+REVCGBLOCKWIDTH);x+=16) {
+					wmem++;
+					// integer in a white gap
+					const int32_t woffset=grayword_offset(data5->memgrau[y],wmem);
+					if (woffset < 0) continue;
+					uint32_t w=data5->zeilen[y][woffset];
 		
-					for(int32_t x=x256;x<(x256+REVCGBLOCKWIDTH);x+=16) {
-						wmem++;
-						uint32_t w;
-						GETDATA5BYMEM_MY(wmem,y,w)
-			
-						// no gray square in this 32-bit integer
-						if (
-							(w == SQUARE_WHITE_16_CONSECUTIVE) ||
-							(w == SQUARE_BLACK_16_CONSECUTIVE) ||
-							(w == SQUARE_GRAYPOTW_16_CONSECUTIVE) 
-						) continue; 
-			
-						uint32_t wneu=w;
-						int32_t w_changed=0;
+					// no gray square in this 32-bit integer
+					if (
+						(w == SQUARE_WHITE_16_CONSECUTIVE) ||
+						(w == SQUARE_BLACK_16_CONSECUTIVE) ||
+						(w == SQUARE_GRAYPOTW_16_CONSECUTIVE) 
+					) continue; 
+		
+					uint32_t wneu=w;
+					int32_t w_changed=0;
+					if (bbxprecomputedrow<=0) {
+						#ifdef _FPA
+						FPA tmp;
+						FPA_mul_ZAuvlong(tmp,scaleRangePerPixel,x);
+						FPA_add_ZAB(A.x1,tmp,COMPLETE0);
+						#else
+						A.x1=x*scaleRangePerPixel + COMPLETE0;
+						#endif
+					} 
+					
+					for(int32_t wbith=0;wbith<16;wbith++) {
 						if (bbxprecomputedrow<=0) {
+							A.x0=A.x1;
 							#ifdef _FPA
-							FPA tmp;
-							FPA_mul_ZAuvlong(tmp,scaleRangePerPixel,x);
-							FPA_add_ZAB(A.x1,tmp,COMPLETE0);
+							FPA_add_ZAB(A.x1,A.x0,scaleRangePerPixel);
 							#else
-							A.x1=x*scaleRangePerPixel + COMPLETE0;
+							A.x1=A.x0+scaleRangePerPixel;
 							#endif
-						} 
+						}
+					
+						uint32_t globalf=w & 0b11;
+						w >>= 2;
+			
+						if (globalf != SQUARE_GRAY) continue;
 						
-						for(int32_t wbith=0;wbith<16;wbith++) {
-							if (bbxprecomputedrow<=0) {
-								A.x0=A.x1;
-								#ifdef _FPA
-								FPA_add_ZAB(A.x1,A.x0,scaleRangePerPixel);
-								#else
-								A.x1=A.x0+scaleRangePerPixel;
-								#endif
-							}
-						
-							uint32_t globalf=w & 0b11;
-							w >>= 2;
-				
-							if (globalf != SQUARE_GRAY) continue;
-							
-							blockhasgray=1;
-							int8_t hits_white=0;
-							int8_t hits_black=0;
+						blockhasgray=1;
+						int8_t hits_white=0;
+						int8_t hits_black=0;
+					
+						if (bbxprecomputedrow>0) {
+							// bbx already computed befprehand
+							// bounding box in special exterior
+							GETPCSCR((woffset << 4)+wbith,y,scr)
 						
-							if (bbxprecomputedrow>0) {
-								// bbx already computed befprehand
-								// bounding box in special exterior
-								GETPCSCR(x+wbith,y,scr)
-							
-								if (scr.x0<0) {
-									// partially or fully outside GRAY ENCLOSMEENT
-									if (scr.x1<0) {
-										// fully
-										wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_WHITE[wbith]);
-										w_changed=1;
-										continue;
-									} else {
-										// partially
-										hits_white=1;
-										scr.x0 = (-scr.x0)-1; // make it valid agfain
-									}
-								}
-							} else {
-								getBoundingBoxfA_helper(
-									A,bbxfA,
-									helperXdep->getHelper(x+wbith),
-									helperY
-								);
-		
-								// bounding box in special exterior
-								if ((SQUARE_LIES_ENTIRELY_OUTSIDE_GRAY_ENCLOSEMENT(bbxfA))>0) {
-									if (bbxprecomputedrow>0) {
-										// scr ist der gespeicherte Wert
-										if (scr.x1>=0) {
-											LOGMSG("Implementation error def1\n");
-											exit(99);
-										}
-									}
+							if (scr.x0<0) {
+								// partially or fully outside GRAY ENCLOSMEENT
+								if (scr.x1<0) {
+									// fully
 									wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_WHITE[wbith]);
 									w_changed=1;
 									continue;
-								}
-					
-								if (SQUARE_LIES_ENTIRELY_IN_GRAY_ENCLOSEMENT(bbxfA) <= 0) {
-									// overlaps with white region
+								} else {
+									// partially
 									hits_white=1;
-									if (bbxprecomputedrow>0) {
-										// scr ist der gespeicherte Wert
-										if (scr.x0>=0) {
-											LOGMSG("Implementation error. def2\n");
-											exit(99);
-										}
-									}
+									scr.x0 = (-scr.x0)-1; // make it valid agfain
 								}
-					
-								scr.x0=scrcoord_as_lowerleft(bbxfA.x0);
-								scr.x1=scrcoord_as_lowerleft(bbxfA.x1);
-								scr.y0=scrcoord_as_lowerleft(bbxfA.y0);
-								scr.y1=scrcoord_as_lowerleft(bbxfA.y1);
-							} // newly computed screenrect done
-						
-							for(int32_t ty=scr.y0;ty<=scr.y1;ty++) {
-								for(int32_t tx=scr.x0;tx<=scr.x1;tx++) {
-									int32_t f;
-									GET_SINGLE_CELLCOLOR_XY(tx,ty,f);
-									switch (f) {
-										case SQUARE_BLACK: hits_black=1; break;
-										case SQUARE_WHITE: hits_white=1; break;
-										default: hits_black=hits_white=1; break;
+							}
+						} else {
+							getBoundingBoxfA_helper(
+								A,bbxfA,
+								helperXdep->getHelper(x+wbith),
+								helperY
+							);
+	
+							// bounding box in special exterior
+							if ((SQUARE_LIES_ENTIRELY_OUTSIDE_GRAY_ENCLOSEMENT(bbxfA))>0) {
+								if (bbxprecomputedrow>0) {
+									// scr ist der gespeicherte Wert
+									if (scr.x1>=0) {
+										LOGMSG("Implementation error def1\n");
+										fatal_exit(99);
 									}
-								
-									if ((hits_white>0)&&(hits_black>0)) break;
-								} // tx
-						
-								if ((hits_white>0)&&(hits_black>0)) break;
-							} // ty
-			
-							if ((hits_white>0) && (hits_black==0) ) {
-								// only white pixels in the bounding box
+								}
 								wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_WHITE[wbith]);
 								w_changed=1;
-							} else if ((hits_black>0) && (hits_white==0) ) {
-								// only black cells are intersected
-								// start can be colored black as well
-								wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_BLACK[wbith]);
-								w_changed=1;
+								continue;
 							}
-						} // wbith
-			
-						if (w_changed>0) {
-							SETDATA5BYMEM_MY(wmem,y,wneu)
-							int32_t BX=x >> REVCGBITS;
-							if (lastBX != BX) {
-								int32_t offset=GLOBALBYOFFSET+BX;
-								for(int32_t i=0;i<data5->revcgYX[offset].howmany;i++) {
-									SETTOVISIT(
-										data5->revcgYX[offset].parent[i].BX,
-										data5->revcgYX[offset].parent[i].BY
-									)
+				
+							if (SQUARE_LIES_ENTIRELY_IN_GRAY_ENCLOSEMENT(bbxfA) <= 0) {
+								// overlaps with white region
+								hits_white=1;
+								if (bbxprecomputedrow>0) {
+									// scr ist der gespeicherte Wert
+									if (scr.x0>=0) {
+										LOGMSG("Implementation error. def2\n");
+										fatal_exit(99);
+									}
 								}
-								lastBX=BX;
 							}
-							changed=1;
-						}
-					} // x
-				} // y
 				
-				if (blockhasgray<=0) {
-					data5->revcgYX[yrevoffset+XBLOCK].containsgray=0;
+							scr.x0=scrcoord_as_lowerleft(bbxfA.x0);
+							scr.x1=scrcoord_as_lowerleft(bbxfA.x1);
+							scr.y0=scrcoord_as_lowerleft(bbxfA.y0);
+							scr.y1=scrcoord_as_lowerleft(bbxfA.y1);
+						} // newly computed screenrect done
+					
+						// gray or potw count as both colors
+						int32_t found=scan_rect_colors(
+							scr,
+							(hits_white>0) 
+								? (RECTSCAN_GRAY | RECTSCAN_GRAYPOTW | RECTSCAN_BLACK)
+								: (RECTSCAN_GRAY | RECTSCAN_GRAYPOTW),
+							RECTSCAN_WHITE | RECTSCAN_BLACK
+						);
+						if (found & (RECTSCAN_WHITE | RECTSCAN_GRAY | RECTSCAN_GRAYPOTW)) hits_white=1;
+						if (found & (RECTSCAN_BLACK | RECTSCAN_GRAY | RECTSCAN_GRAYPOTW)) hits_black=1;
+		
+						if ((hits_white>0) && (hits_black==0) ) {
+							// only white pixels in the bounding box
+							wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_WHITE[wbith]);
+							w_changed=1;
+						} else if ((hits_black>0) && (hits_white==0) ) {
+							// only black cells are intersected
+							// start can be colored black as well
+							wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_BLACK[wbith]);
+							w_changed=1;
+						}
+					} // wbith
+		
+					if (w_changed>0) {
+						SETDATA5BYOFFSET(woffset,y,wneu)
+						if (x < dirtyx0) dirtyx0=x;
+						if ((x+15) > dirtyx1) dirtyx1=x+15;
+						if (y < dirtyy0) dirtyy0=y;
+						if (y > dirtyy1) dirtyy1=y;
+						changed=1;
+					}
+				} // x
+			} // y
+			
+			if (dirtyx1 >= 0) {
+				// only parents whose image touches a changed
+				// integer can change in turn
+				SETPARENTSTOVISIT(XBLOCK,GLOBALBY,dirtyx0,dirtyx1,dirtyy0,dirtyy1)
+				if (_SYMMETRY>0) {
+					// the mirrored tile changed as well
+					SETPARENTSTOVISIT(
+						XBLOCK,REVCGmaxnumber-1-GLOBALBY,
+						dirtyx0,dirtyx1,
+						SCREENWIDTH-1-dirtyy1,SCREENWIDTH-1-dirtyy0
+					)
 				}
-			} // X256
-		} // Y256
+			}
+			
+			if (blockhasgray<=0) {
+				REVCGCLEARBIT(data5->revcgcontainsgray,tileidx)
+			}
+		} // tiles
+		
+		// integers that turned white leave their spans,
+		// whole chunks freed by that are released
+		data5->tightenRows(0);
+		int64_t released=data5->compactMemory();
+		if (released > 0) printf("\n  compaction released %I64d MB ",released >> 20);
 	} // while
+	
+	LOGMSG3("\npropagating definite color: %i passes (order %s)\n",passes,ordername[_ORDER]);
 }
 
 void propagate_potw(void) {
@@ -5138,9 +7159,20 @@ void propagate_potw(void) {
 	int32_t noch=1;
 	
 	// mark every tile as to be visited
-	for(int32_t i=0;i<REVCGmaxnumberQ;i++) {
-		data5->revcgYX[i].tovisit=1;
-		data5->revcgYX[i].containsgray=1;
+	for(int32_t i=0;i<=(REVCGmaxnumberQ >> 6);i++) {
+		data5->revcgtovisit[i]=~(uint64_t)0;
+		data5->revcgcontainsgray[i]=~(uint64_t)0;
+	}
+
+	// the first sweep collects the graph for the reverse search,
+	// if it does not fit into the memory given, sweeps continue
+	PotwBFS* bfs=NULL;
+	if (_POTWBFSMEMORYGB>0) {
+		bfs=new PotwBFS;
+		if (bfs->init((int64_t)_POTWBFSMEMORYGB << 30) <= 0) {
+			delete bfs;
+			bfs=NULL;
+		}
 	}
 
 	changed=1;
@@ -5150,7 +7182,7 @@ void propagate_potw(void) {
 		printf("\npropagating potentially white ... ");
 	
 		for(int32_t y256=0,YBLOCK=0;y256<SCREENWIDTH;y256+=REVCGBLOCKWIDTH,YBLOCK++) {
-			int32_t yrevoffset=YBLOCK*REVCGmaxnumber;
+			int64_t yrevoffset=(int64_t)YBLOCK*REVCGmaxnumber;
 			if ( (--noch) <= 0) {
 				printf("%i ",SCREENWIDTH-y256);
 				noch=noch0;
@@ -5160,7 +7192,7 @@ void propagate_potw(void) {
 				int32_t t2=clock();
 				if ((t2-lastsavetime) > CLOCKHOURSTOSAVE) {
 					printf("saving raw data ... ");
-					data5->saveRaw("_temp");
+					data5->saveRaw(TEMPFN);
 					printf("done\n");
 					lastsavetime=t2;
 				}
@@ -5169,22 +7201,20 @@ void propagate_potw(void) {
 			// outside gray enclosement => jump out
 			if ( (y256+REVCGBLOCKWIDTH) < encgrayy0) continue;
 			if (y256 > encgrayy1) break;
+			// upper half mirrors the lower one
+			if ( (_SYMMETRY>0) && (y256 >= (SCREENWIDTH >> 1)) ) break;
 	
-			int32_t lastBX=-1;
 			int32_t GLOBALBY=y256 >> REVCGBITS;
-			int32_t GLOBALBYOFFSET=GLOBALBY*REVCGmaxnumber;
 
 			for(int32_t x256=0,XBLOCK=0;x256<SCREENWIDTH;x256+=REVCGBLOCKWIDTH,XBLOCK++) {
-				if ( (data5->revcgYX[yrevoffset+XBLOCK].tovisit<=0) ) {
-					continue;
-				}
+				// jump to the next tile to visit that still has gray
+				int64_t tileidx=next_revcg_tile(yrevoffset+XBLOCK,yrevoffset+REVCGmaxnumber);
+				if (tileidx < 0) break;
+				XBLOCK=tileidx-yrevoffset;
+				x256=XBLOCK << REVCGBITS;
 				
-				if (data5->revcgYX[yrevoffset+XBLOCK].containsgray<=0) {
-					continue;
-				}
-		
 				// block has now been checked
-				data5->revcgYX[yrevoffset+XBLOCK].tovisit=0;
+				REVCGCLEARBIT(data5->revcgtovisit,tileidx)
 	
 				const int32_t Y256ENDE=y256+REVCGBLOCKWIDTH;
 				#ifdef _FPA
@@ -5195,6 +7225,9 @@ void propagate_potw(void) {
 				#endif
 				
 				int8_t blockhasgray=0;
+				// pixels of the integers that changed in this tile
+				int32_t dirtyx0=SCREENWIDTH,dirtyx1=-1;
+				int32_t dirtyy0=SCREENWIDTH,dirtyy1=-1;
 				
 				for(int32_t y=y256;y<Y256ENDE;y++) {
 					A.y0=A.y1;
@@ -5208,23 +7241,18 @@ void propagate_potw(void) {
 					if (data5->pcscr) {
 						if (data5->pcscr[y]) bbxprecomputedrow=1;
 					}
-					const int32_t xanf=data5->memgrau[y].g0;
-					const int32_t xende=data5->memgrau[y].g1;
-					if (xende < xanf) continue;
-		
-					// gray in that row lies outside of area to be checked
-					if ( 
-						(x256 > xende) ||
-						( (x256+REVCGBLOCKWIDTH) < xanf) 
-					) continue;
+					// gray spans of that row outside of area to be checked
+					if (data5->memgrau[y].overlaps(x256,x256+REVCGBLOCKWIDTH-1) <= 0) continue;
 				
 					Helper *helperY=helperYdep->getHelper(y);
 					int32_t wmem=-1 + (x256 >> 4);
 		
 					for(int32_t x=x256;x<(x256+REVCGBLOCKWIDTH);x+=16) {
 						wmem++;
-						uint32_t w;
-						GETDATA5BYMEM_MY(wmem,y,w)
+						// integer in a white gap
+						const int32_t woffset=grayword_offset(data5->memgrau[y],wmem);
+						if (woffset < 0) continue;
+						uint32_t w=data5->zeilen[y][woffset];
 			
 						// no gray square in this 32-bit integer
 						if (
@@ -5266,12 +7294,13 @@ void propagate_potw(void) {
 							int32_t pathtowhite=0;
 						
 							if (bbxprecomputedrow>0) {
-								GETPCSCR(x+wbith,y,scr)
+								GETPCSCR((woffset << 4)+wbith,y,scr)
 								if (scr.x0<0) {
 									if (scr.x1<0) {
 										// fully outside GRAY ENCLOSMEENT
 										wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_WHITE[wbith]);
 										w_changed=1;
+										if (bfs) bfs->addChanged(x+wbith,y);
 										continue;
 									} else {
 										// partially outside
@@ -5293,11 +7322,12 @@ void propagate_potw(void) {
 										// scr ist der gespeicherte Wert
 										if (scr.x1>=0) {
 											LOGMSG("Implementation error. potw1\n");
-											exit(99);
+											fatal_exit(99);
 										}
 									}
 									wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_WHITE[wbith]);
 									w_changed=1;
+									if (bfs) bfs->addChanged(x+wbith,y);
 									continue;
 								}
 				
@@ -5309,7 +7339,7 @@ void propagate_potw(void) {
 										// scr ist der gespeicherte Wert
 										if (scr.x0>=0) {
 											LOGMSG("Implementation error. potw/2\n");
-											exit(99);
+											fatal_exit(99);
 										}
 									}
 								} 
@@ -5321,121 +7351,340 @@ void propagate_potw(void) {
 							} // newly computed bbx
 						
 							if (pathtowhite <= 0) {
-								for(int32_t ty=scr.y0;ty<=scr.y1;ty++) {
-									for(int32_t tx=scr.x0;tx<=scr.x1;tx++) {
-										int32_t f;
-										GET_SINGLE_CELLCOLOR_XY(tx,ty,f);
-										if (
-											(f==SQUARE_WHITE) ||
-											(f==SQUARE_GRAY_POTENTIALLY_WHITE)
-										) {
-											pathtowhite=1;
-											break;
-										}
-									
-										if (pathtowhite>0) break;
-									} // tx
-							
-									if (pathtowhite>0) break;
-								} // ty
+								if (scan_rect_colors(
+									scr,
+									RECTSCAN_WHITE | RECTSCAN_GRAYPOTW,0
+								) & (RECTSCAN_WHITE | RECTSCAN_GRAYPOTW)) {
+									pathtowhite=1;
+								}
 							}
 				
 							if (pathtowhite>0) {
 								wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_GRAYPOTW[wbith]);
 								w_changed=1;
-							}
+								if (bfs) bfs->addChanged(x+wbith,y);
+							} else if (bfs) bfs->addSource(x+wbith,y,scr);
 						} // wbith
 			
 						if (w_changed>0) {
-							SETDATA5BYMEM_MY(wmem,y,wneu)
-							int32_t BX=x >> REVCGBITS;
-							if (lastBX != BX) {
-								int32_t offset=GLOBALBYOFFSET+BX;
-								for(int32_t i=0;i<data5->revcgYX[offset].howmany;i++) {
-									SETTOVISIT(
-										data5->revcgYX[offset].parent[i].BX,
-										data5->revcgYX[offset].parent[i].BY
-									)
-								}
-								lastBX=BX;
-							} 
+							SETDATA5BYOFFSET(woffset,y,wneu)
+							if (x < dirtyx0) dirtyx0=x;
+							if ((x+15) > dirtyx1) dirtyx1=x+15;
+							if (y < dirtyy0) dirtyy0=y;
+							if (y > dirtyy1) dirtyy1=y;
 							changed=1;
 						}
 					} // x
 				} // y
 				
+				if (dirtyx1 >= 0) {
+					// only parents whose image touches a changed
+					// integer can change in turn
+					SETPARENTSTOVISIT(XBLOCK,GLOBALBY,dirtyx0,dirtyx1,dirtyy0,dirtyy1)
+					if (_SYMMETRY>0) {
+						// the mirrored tile changed as well
+						SETPARENTSTOVISIT(
+							XBLOCK,REVCGmaxnumber-1-GLOBALBY,
+							dirtyx0,dirtyx1,
+							SCREENWIDTH-1-dirtyy1,SCREENWIDTH-1-dirtyy0
+						)
+					}
+				}
+				
 				if (blockhasgray<=0) {
-					data5->revcgYX[yrevoffset+XBLOCK].containsgray=0;
+					REVCGCLEARBIT(data5->revcgcontainsgray,tileidx)
 				}
 			} // X256
 		} // Y256
+		
+		if (bfs) {
+			if (changed>0) {
+				printf("\npropagating potentially white by reverse search ... ");
+				if (bfs->buildGraph() > 0) {
+					bfs->run();
+					changed=0;
+				} else printf("graph too large, sweeping ");
+			}
+			delete bfs;
+			bfs=NULL;
+		}
 	} // while
 }
 
-int color_changeS32(
-	const DDBYTE source1,const DDBYTE target1,
-	const DDBYTE source16,const DDBYTE target16
-) {
+PotwBFS::PotwBFS() {
+	capacity=maxbytes=0;
+	sources=NULL;
+	anzsources=0;
+	tileoffset=NULL;
+	tilesources=NULL;
+	tilechanged=NULL;
+	reached=0;
+}
+
+PotwBFS::~PotwBFS() {
+	if (sources) delete[] sources;
+	if (tileoffset) delete[] tileoffset;
+	if (tilesources) delete[] tilesources;
+	if (tilechanged) delete[] tilechanged;
+}
+
+// returns 0 if the gray pixels do not fit into amaxbytes
+int8_t PotwBFS::init(const int64_t amaxbytes) {
+	maxbytes=amaxbytes;
+	
+	// every gray pixel in the propagated rows is at most once a source
+	int32_t yend=SCREENWIDTH;
+	if (_SYMMETRY>0) yend=SCREENWIDTH >> 1;
+	capacity=0;
+	for(int32_t y=0;y<yend;y++) {
+		if (!data5->zeilen[y]) continue;
+		const int32_t anzwords=data5->memgrau[y].words();
+		for(int32_t woffset=0;woffset<anzwords;woffset++) {
+			DDBYTE w=data5->zeilen[y][woffset];
+			if (
+				(w == SQUARE_WHITE_16_CONSECUTIVE) ||
+				(w == SQUARE_BLACK_16_CONSECUTIVE) ||
+				(w == SQUARE_GRAYPOTW_16_CONSECUTIVE)
+			) continue;
+			for(int32_t b=0;b<16;b++) {
+				if ((w & 0b11) == SQUARE_GRAY) capacity++;
+				w >>= 2;
+			}
+		}
+	} // y
+	
+	int64_t needed=
+		capacity*sizeof(PotwSource)
+		+ ((int64_t)REVCGmaxnumberQ+1)*sizeof(uint32_t)
+		+ ((REVCGmaxnumberQ >> 6)+1)*sizeof(uint64_t);
+	if ( (needed > maxbytes) || (capacity >= ((int64_t)1 << 32)) ) return 0;
+	
+	sources=new PotwSource[capacity+1];
+	tileoffset=new uint32_t[(int64_t)REVCGmaxnumberQ+1];
+	tilechanged=new uint64_t[(REVCGmaxnumberQ >> 6)+1];
+	for(int32_t i=0;i<=(REVCGmaxnumberQ >> 6);i++) tilechanged[i]=0;
+	anzsources=0;
+	
+	return 1;
+}
+
+void PotwBFS::addSource(const int32_t ax,const int32_t ay,const ScreenRect& ascr) {
+	if (anzsources >= capacity) {
+		LOGMSG("Implementation error. PotwBFS sources.\n");
+		fatal_exit(99);
+	}
+	sources[anzsources].x=ax;
+	sources[anzsources].y=ay;
+	sources[anzsources].scr=ascr;
+	anzsources++;
+}
+
+// pixel (ax,ay) of the lower half (if symmetric) changed
+void PotwBFS::addChanged(const int32_t ax,const int32_t ay) {
+	int64_t tileidx=(int64_t)(ay >> REVCGBITS)*REVCGmaxnumber+(ax >> REVCGBITS);
+	REVCGSETBIT(tilechanged,tileidx)
+	if (_SYMMETRY>0) {
+		// the mirrored pixel changed as well
+		tileidx=(int64_t)(REVCGmaxnumber-1-(ay >> REVCGBITS))*REVCGmaxnumber+(ax >> REVCGBITS);
+		REVCGSETBIT(tilechanged,tileidx)
+	}
+}
+
+// returns 0 if the tile index does not fit into maxbytes
+int8_t PotwBFS::buildGraph(void) {
+	for(int64_t i=0;i<=REVCGmaxnumberQ;i++) tileoffset[i]=0;
+	
+	// first pass: counting sources per tile
+	int64_t total=0;
+	for(int64_t i=0;i<anzsources;i++) {
+		const ScreenRect& scr=sources[i].scr;
+		for(int32_t by=(scr.y0 >> REVCGBITS);by<=(scr.y1 >> REVCGBITS);by++) {
+			int64_t yoffset=(int64_t)by*REVCGmaxnumber;
+			for(int32_t bx=(scr.x0 >> REVCGBITS);bx<=(scr.x1 >> REVCGBITS);bx++) {
+				tileoffset[yoffset+bx]++;
+			}
+		}
+		total += 
+			(int64_t)((scr.y1 >> REVCGBITS)-(scr.y0 >> REVCGBITS)+1)*
+			((scr.x1 >> REVCGBITS)-(scr.x0 >> REVCGBITS)+1);
+		if (total >= ((int64_t)1 << 32)) return 0;
+	}
+	
+	int64_t needed=
+		capacity*sizeof(PotwSource)
+		+ ((int64_t)REVCGmaxnumberQ+1+total)*sizeof(uint32_t)
+		+ ((REVCGmaxnumberQ >> 6)+1)*sizeof(uint64_t);
+	if (needed > maxbytes) return 0;
+	
+	// counts to offsets, used as write cursors in the 2nd pass
+	int64_t sum=0;
+	for(int64_t i=0;i<REVCGmaxnumberQ;i++) {
+		int64_t cnt=tileoffset[i];
+		tileoffset[i]=sum;
+		sum += cnt;
+	}
+	tileoffset[REVCGmaxnumberQ]=sum;
+	
+	tilesources=new uint32_t[total+1];
+	for(int64_t i=0;i<anzsources;i++) {
+		const ScreenRect& scr=sources[i].scr;
+		for(int32_t by=(scr.y0 >> REVCGBITS);by<=(scr.y1 >> REVCGBITS);by++) {
+			int64_t yoffset=(int64_t)by*REVCGmaxnumber;
+			for(int32_t bx=(scr.x0 >> REVCGBITS);bx<=(scr.x1 >> REVCGBITS);bx++) {
+				tilesources[tileoffset[yoffset+bx]]=i;
+				tileoffset[yoffset+bx]++;
+			}
+		}
+	}
+	
+	// cursors point to the next tile's start: shift back
+	for(int64_t i=REVCGmaxnumberQ-1;i>0;i--) tileoffset[i]=tileoffset[i-1];
+	tileoffset[0]=0;
+	
+	return 1;
+}
+
+// sources covering the changed tile whose rectangle now
+// hits white or potentially white become potentially white
+void PotwBFS::checkTile(const int64_t atile) {
+	for(uint32_t i=tileoffset[atile];i<tileoffset[atile+1];i++) {
+		PotwSource& src=sources[tilesources[i]];
+		// already reached
+		if (src.scr.x0 < 0) continue;
+		
+		if ((scan_rect_colors(
+			src.scr,
+			RECTSCAN_WHITE | RECTSCAN_GRAYPOTW,0
+		) & (RECTSCAN_WHITE | RECTSCAN_GRAYPOTW)) == 0) continue;
+		
+		DDBYTE w;
+		GETDATA5BYMEM_MY(src.x >> 4,src.y,w)
+		const int32_t wbith=src.x & 15;
+		w=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(w,COLOR_CLEARMASK[wbith],ARRAY_SQUARE_GRAYPOTW[wbith]);
+		SETDATA5BYMEM_MY(src.x >> 4,src.y,w)
+		src.scr.x0=-1;
+		reached++;
+		addChanged(src.x,src.y);
+	}
+}
+
+void PotwBFS::run(void) {
+	const int64_t words=(REVCGmaxnumberQ >> 6)+1;
+	reached=0;
+	
+	// visit changed tiles in index order, wrapping
+	// around until no tile is left
+	int8_t anyleft=1;
+	while (anyleft>0) {
+		anyleft=0;
+		for(int64_t wi=0;wi<words;wi++) {
+			while (tilechanged[wi] != 0) {
+				int64_t tileidx=(wi << 6) + __builtin_ctzll(tilechanged[wi]);
+				REVCGCLEARBIT(tilechanged,tileidx)
+				if (tileidx >= REVCGmaxnumberQ) continue;
+				checkTile(tileidx);
+			}
+		}
+		for(int64_t wi=0;wi<words;wi++) {
+			if (tilechanged[wi] != 0) {
+				anyleft=1;
+				break;
+			}
+		}
+	}
+	
+	printf("%I64d sources, %I64d reached ",anzsources,reached);
+}
+
+// lane mask (low bits) of the pixels of w that have color ac
+static inline uint32_t lanes_of_color(const uint32_t w,const uint32_t ac) {
+	const uint32_t x=w ^ CFALL(ac);
+	
+	return ~(x | (x >> 1)) & LANES_LOWBIT;
+}
+
+// every pixel of color asource is set to atarget, all 16 pixels of a
+// 32bit integer at once (8 integers per instruction with AVX2).
+// Returns 1 if a pixel was changed or a black pixel exists, including
+// black gaps
+int32_t color_changeS32(const DDBYTE asource,const DDBYTE atarget) {
+	const uint32_t target16=CFALL(atarget);
 	int32_t res=0;
 	int32_t noch0=SCREENWIDTH >> 3;
 	int32_t noch=1;
 	
+	#ifdef _RECTSCANAVX2
+	const __m256i lowbit=_mm256_set1_epi32((int)LANES_LOWBIT);
+	const __m256i vsource=_mm256_set1_epi32((int)CFALL(asource));
+	const __m256i vblack=_mm256_set1_epi32((int)SQUARE_BLACK_16_CONSECUTIVE);
+	const __m256i vwhite=_mm256_set1_epi32((int)SQUARE_WHITE_16_CONSECUTIVE);
+	const __m256i vtarget=_mm256_set1_epi32((int)target16);
+	const __m256i vzero=_mm256_setzero_si256();
+	#define LANESOFCOLOR(VV,VC) \
+		_mm256_andnot_si256(\
+			_mm256_or_si256(_mm256_xor_si256(VV,VC),_mm256_srli_epi32(_mm256_xor_si256(VV,VC),1)),\
+			lowbit\
+		)
+	#endif
+	
 	for(int32_t y=0;y<SCREENWIDTH;y++) {
 		if ((--noch)<=0) {
 			printf("%i ",SCREENWIDTH-y);
 			noch=noch0;
 		}
-		const int32_t xanf=data5->memgrau[y].g0;
-		const int32_t xende=data5->memgrau[y].g1;
-		int32_t mem=-1 + (xanf >> 4);
-
-		for(int32_t x=xanf;x<=xende;x+=16) {
-			mem++; 
-			uint32_t w;
-			GETDATA5BYMEM_MY(mem,y,w)
-			uint32_t wneu=w;
-			uint8_t w_changed=0;
+		Gray_in_row* mg=&data5->memgrau[y];
+		for(int32_t sp=0;sp<mg->anzspans;sp++) {
+			if (mg->spans[sp].blackbefore > 0) res=1;
+		}
+		// the spans' integers lie consecutively in memory
+		const int32_t anzwords=mg->words();
+		DDBYTE* row=data5->zeilen[y];
+		// lanes changed or black
+		uint32_t found=0;
+		int32_t woffset=0;
+		
+		#ifdef _RECTSCANAVX2
+		__m256i accfound=vzero;
+		for(;(woffset+8)<=anzwords;woffset+=8) {
+			const __m256i v=_mm256_loadu_si256((const __m256i*)&row[woffset]);
+			const __m256i m=LANESOFCOLOR(v,vsource);
+			accfound=_mm256_or_si256(accfound,_mm256_or_si256(m,LANESOFCOLOR(v,vblack)));
+			if (_mm256_testz_si256(m,m)) continue;
 			
-			if (w == source16) {
-				wneu=target16;
-				w_changed=1;
-				res=1;
-			} else {
-				for(int32_t b=0;b<16;b++) {
-					int32_t f=w & 0b11;
-					w >>= 2;
-					if (f == source1) {
-						w_changed=1;
-						switch (target1) {
-							case SQUARE_BLACK:
-								wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[b],ARRAY_SQUARE_BLACK[b]);
-								break;
-							case SQUARE_GRAY_POTENTIALLY_WHITE:
-								wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[b],ARRAY_SQUARE_GRAYPOTW[b]);
-								break;
-							case SQUARE_WHITE:
-								wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[b],ARRAY_SQUARE_WHITE[b]);
-								break;
-							default:
-								// setting a cell to GRAY
-								// is never an error
-								wneu=SET_SINGLE_PIXELCOLOR_INTO_4BYTEINTEGER(wneu,COLOR_CLEARMASK[b],ARRAY_SQUARE_GRAY[b]);
-								break;
-						}
-					
-						res=1;
-					} else if (f == SQUARE_BLACK) {
-						res=1;
-					}
-				} // b
-			} // single
+			const __m256i m2=_mm256_or_si256(m,_mm256_slli_epi32(m,1));
+			const __m256i wneu=_mm256_or_si256(
+				_mm256_andnot_si256(m2,v),
+				_mm256_and_si256(vtarget,m2)
+			);
+			_mm256_storeu_si256((__m256i*)&row[woffset],wneu);
 			
-			if (w_changed>0) {
-				SETDATA5BYMEM_MY(mem,y,wneu)
-			}
-		} // x
+			// changed integers that became settled, see SETDATA5BYOFFSET
+			__m256i settles=_mm256_cmpeq_epi32(wneu,vwhite);
+			if (_BLACKGAPS>0) settles=_mm256_or_si256(settles,_mm256_cmpeq_epi32(wneu,vblack));
+			settles=_mm256_andnot_si256(_mm256_cmpeq_epi32(m,vzero),settles);
+			if (!_mm256_testz_si256(settles,settles)) mg->settled=1;
+		}
+		if (!_mm256_testz_si256(accfound,accfound)) found=1;
+		#endif
+		
+		for(;woffset<anzwords;woffset++) {
+			const uint32_t w=row[woffset];
+			const uint32_t m=lanes_of_color(w,asource);
+			found |= m | lanes_of_color(w,SQUARE_BLACK);
+			if (m == 0) continue;
+			
+			const uint32_t m2=m | (m << 1);
+			const uint32_t wneu=(w & ~m2) | (target16 & m2);
+			SETDATA5BYOFFSET(woffset,y,wneu)
+		} // woffset
+		
+		if (found != 0) res=1;
 	} // y
 	
+	#ifdef _RECTSCANAVX2
+	#undef LANESOFCOLOR
+	#endif
+	
 	return res;
 }
 
@@ -5471,7 +7720,7 @@ RefPoint* RefList::getRefPtr(const int32_t ax) {
 void RefList::addXB(const int32_t ax,const int32_t ablobid) {
 	if (anz >= memused) {
 		LOGMSG("Implementation error RefList. Too many XB values.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	points[anz].x=ax;
 	points[anz].blobid=ablobid;
@@ -5490,6 +7739,15 @@ ParentManager::ParentManager() {
 	memused=0;
 	freefrom=0;
 	anzptr=0;
+	reuseidx=0;
+}
+
+// all parents are considered free, chunks are kept
+void ParentManager::rewind(void) {
+	lastallocated=NULL;
+	memused=0;
+	freefrom=0;
+	reuseidx=0;
 }
 
 ParentManager::~ParentManager() {
@@ -5504,17 +7762,23 @@ Parent* ParentManager::getParentSpace(const int32_t aneeded) {
 		(!lastallocated) ||
 		( (memused-freefrom) < aneeded)
 	) {
-		if (anzptr >= MAXPTR) {
-			LOGMSG("Error. Memory parentManager.\n");
-			exit(99);
-		}
-		printf("x");
 		int64_t all=CHUNKSIZE / sizeof(Parent);
-		ptr[anzptr]=lastallocated=new Parent[all];
-		anzptr++;
-		if (!lastallocated) {
-			LOGMSG("Error/2. Memory parentManager.\n");
-			exit(99);
+		if (reuseidx < anzptr) {
+			lastallocated=ptr[reuseidx];
+			reuseidx++;
+		} else {
+			if (anzptr >= MAXPTR) {
+				LOGMSG("Error. Memory parentManager.\n");
+				fatal_exit(99);
+			}
+			printf("x");
+			ptr[anzptr]=lastallocated=new Parent[all];
+			anzptr++;
+			reuseidx=anzptr;
+			if (!lastallocated) {
+				LOGMSG("Error/2. Memory parentManager.\n");
+				fatal_exit(99);
+			}
 		}
 		memused=all;
 		freefrom=0;
@@ -5597,12 +7861,7 @@ void periodicity_m3(char* afn) {
 	printf("initializing Fatou component search ... ");
 	// change every graypotw to gray
 	// graypotw gis later used as flag "visited"
-	color_changeS32(
-		SQUARE_GRAY_POTENTIALLY_WHITE,
-		SQUARE_GRAY,
-		SQUARE_GRAYPOTW_16_CONSECUTIVE,
-		SQUARE_GRAY_16_CONSECUTIVE
-	);
+	color_changeS32(SQUARE_GRAY_POTENTIALLY_WHITE,SQUARE_GRAY);
 	
 	uint32_t SQUARE_VISITED=SQUARE_GRAY_POTENTIALLY_WHITE;
 	
@@ -5641,7 +7900,7 @@ void periodicity_m3(char* afn) {
 			
 			if (y==0) {
 				LOGMSG("Error. m3/1\n");
-				exit(99);
+				fatal_exit(99);
 			}
 			
 			int32_t fsouth;
@@ -5668,7 +7927,7 @@ void periodicity_m3(char* afn) {
 			
 			if (y==0) {
 				LOGMSG("Error/2 m3.\n");
-				exit(99);
+				fatal_exit(99);
 			}
 			
 			int32_t fsouth;
@@ -5737,19 +7996,19 @@ void periodicity_m3(char* afn) {
 								if ( (p->blobid>0) && (p->blobid != (BLOBID)) ) {\
 									LOGMSG3("Error/3. blobid inconsistency: has %i, set to %i\n",\
 										p->blobid,BLOBID);\
-									exit(99);\
+									fatal_exit(99);\
 								} else {\
 									p->blobid=BLOBID;\
 								}\
 							} else {\
 								LOGMSG3("Error/M3. refpoint ptr null %i,%i\n",\
 									ERGX0,REFY);\
-								exit(99);\
+								fatal_exit(99);\
 							}\
 						}\
 					} else {\
 						LOGMSG("Error/periodM3. Not able to analyze reference points in bottom row.\n");\
-							exit(99);\
+							fatal_exit(99);\
 					}\
 					ERGX0--;\
 				}\
@@ -5774,19 +8033,19 @@ void periodicity_m3(char* afn) {
 								if ( (p->blobid>0) && (p->blobid != (BLOBID)) ) {\
 									LOGMSG3("Error/3. blobid inconsistency: has %i, set to %i\n",\
 										p->blobid,BLOBID);\
-									exit(99);\
+									fatal_exit(99);\
 								} else {\
 									p->blobid=BLOBID;\
 								}\
 							} else {\
 								LOGMSG3("Error/M3. refpoint ptr null %i,%i\n",\
 									ERGX1,REFY);\
-								exit(99);\
+								fatal_exit(99);\
 							}\
 						}\
 					} else {\
 						LOGMSG("Error/periodM3. Not able to analyze reference points in bottom row.\n");\
-							exit(99);\
+							fatal_exit(99);\
 					}\
 					ERGX1++;\
 				}\
@@ -5828,7 +8087,7 @@ void periodicity_m3(char* afn) {
 					}
 				} else {
 					LOGMSG("Periodicity/m3. error. streak at y=0 not possible\n");
-					exit(99);
+					fatal_exit(99);
 				}
 				
 				// go one row down: if pixel black
@@ -5845,7 +8104,7 @@ void periodicity_m3(char* afn) {
 					}
 				} else {
 					LOGMSG("Periodicity/m3. error. streak at topmost row not possible\n");
-					exit(99);
+					fatal_exit(99);
 				}
 				// => new streak pushed
 			} // while streaks
@@ -5853,7 +8112,7 @@ void periodicity_m3(char* afn) {
 			nextblobid++;
 			if (nextblobid > (MAXBLOBID-8)) {
 				LOGMSG("Error. Too many blobs.\n");
-				exit(99);
+				fatal_exit(99);
 			}
 		} // rp
 	} // y
@@ -5923,7 +8182,7 @@ void periodicity_m3(char* afn) {
 		for(int32_t rp=0;rp<refpoints->listY[y].anz;rp++) {
 			if (refpoints->listY[y].points[rp].blobid <= 0) {
 				LOGMSG("Error. Period/M3 at item4: blobid not determined.\n");
-				exit(99);
+				fatal_exit(99);
 			}
 			
 			RefPoint* pcurrblob=&refpoints->listY[y].points[rp];
@@ -5984,7 +8243,7 @@ void periodicity_m3(char* afn) {
 					(ptarget->blobid <= 0)
 				) {
 					LOGMSG3("Error. Period/M3. Target ref point %i,%i not found\n",rx,ry);
-					exit(99);
+					fatal_exit(99);
 				}
 				
 				currentx=rx;
@@ -6036,7 +8295,7 @@ void periodicity_m3(char* afn) {
 			
 			if (orbit0<0) {
 				LOGMSG("Error. Period/M3 no orbit found\n");
-				exit(99);
+				fatal_exit(99);
 			}
 			
 			// [o0].blobid==[o1].blobid, d.h. laenge ist diff
@@ -6072,7 +8331,9 @@ void periodicity_m3(char* afn) {
 	} // y
 	
 	printf("\n%i cycles detected\n",anzcycles);
+	jobsummary.anzcycles=anzcycles;
 	for(int32_t cyc=0;cyc<anzcycles;cyc++) {
+		if (cyc < MAXSUMMARYCYCLES) jobsummary.cyclelen[cyc]=cycles[cyc].len;
 		LOGMSG6("  cycle #%i len=%i immediate RGB(%i,%i,%i)\n",
 			cyc,cycles[cyc].len,
 			periodpal.rgbs[cycles[cyc].color].R,
@@ -6105,7 +8366,7 @@ void periodicity_m3(char* afn) {
 	FILE *fbmp=fopen(tmp,"wb");
 	if (!fbmp) {
 		fprintf(stderr,"Error. twd16\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	write2(fbmp,66,77); 
 	fwrite(&filelen,1,sizeof(filelen),fbmp);
@@ -6146,7 +8407,7 @@ void periodicity_m3(char* afn) {
 		\
 		if (ry <= 0) {\
 			LOGMSG("PeriodM3. save image, reference point below bottom.\n");\
-			exit(99);\
+			fatal_exit(99);\
 		}\
 		ERGPTR=refpoints->getRefPtr(rx,ry);\
 	}
@@ -6203,7 +8464,7 @@ void periodicity_m3(char* afn) {
 	
 						if (!ptr) {
 							LOGMSG("PeriodM3. save image, reference point not found as pointer.\n");
-							exit(99);
+							fatal_exit(99);
 						}
 						
 						lastblob=ptr->blobid;
@@ -6280,7 +8541,7 @@ void periodicity(char* afn) {
 				dbY[y]=mgr->getMemory(xlen);
 				if (!dbY[y]) {
 					LOGMSG("Error/periodicity.\n");
-					exit(99);
+					fatal_exit(99);
 				}
 				int32_t dbx=data5->memgrau[y].g0;
 				for(int32_t m=m0;m<=m1;m++) {
@@ -6478,7 +8739,7 @@ void periodicity(char* afn) {
 			
 				if (anzliste != 0) {
 					LOGMSG3("Implementation error. new blob#%i, but list with %I64d elements\n",anzfatouinorbit,anzliste);
-					exit(99);
+					fatal_exit(99);
 				}
 				ADDLISTE(x,y)
 				bx0=bx1=x;
@@ -6514,7 +8775,7 @@ void periodicity(char* afn) {
 					// check for voxels to follow
 					if ((anzliste>0) || (changed>0)) {
 						LOGMSG2("Implementation error. list mistake %I64d elements, 0 expected\n",anzliste);
-						exit(99);
+						fatal_exit(99);
 					} else {
 						// per cube
 						for(int32_t by=ey0;by<=ey1;by++) {
@@ -6557,7 +8818,7 @@ void periodicity(char* afn) {
 					
 					if (SQUARE_LIES_ENTIRELY_IN_SPECEXT(bbxfA) > 0) {
 						LOGMSG("Implementation error. No target Fatou component.\n");
-						exit(99);
+						fatal_exit(99);
 					}
 				
 					ScreenRect scr;
@@ -6571,7 +8832,7 @@ void periodicity(char* afn) {
 						(scr.y0<0) || (scr.y0 >= SCREENWIDTH) 
 					) {
 						LOGMSG("Implementation error. BbxfA is inconsistent.\n");
-						exit(99);
+						fatal_exit(99);
 					}
 					
 					int32_t vf;
@@ -6599,7 +8860,7 @@ void periodicity(char* afn) {
 							LOGMSG("Implementation error. No cycle in orbit\n");
 							LOGMSG4("anzcycles %i currorbitidx %i currentOrbitColorIdxTemp %i\n",
 								anzcycles,currorbitidx,oneorbit[currorbitidx].currentOrbitColorIdxTemp);
-							exit(99);
+							fatal_exit(99);
 						}
 						
 						cycles[anzcycles].len=currorbitidx-o0+1;
@@ -6631,14 +8892,14 @@ void periodicity(char* afn) {
 						anzcycles++;
 						if (anzcycles >= (MAXCYCLES-2)) {
 							LOGMSG("Not possible: Too many cycles (yet to be implemented).\n");
-							exit(99);
+							fatal_exit(99);
 						}
 						
 						cyclesetnbrimmediate+=2;;
 						cyclesetnbrattraction+=2;
 						if (cyclesetnbrattraction >= MINTEMPCOLOR) {
 							LOGMSG("Implementation error. Too many cycles.\n");
-							exit(99);
+							fatal_exit(99);
 						}
 						
 						if (currorbitidx > maxorbitlen) maxorbitlen=currorbitidx;
@@ -6658,7 +8919,7 @@ void periodicity(char* afn) {
 						
 						if (zyklus<0) {
 							LOGMSG("Implementation error. Found cycle not detected in orbit\n");
-							exit(99);
+							fatal_exit(99);
 						}
 						
 						// whole orbit is attraction basin
@@ -6673,7 +8934,9 @@ void periodicity(char* afn) {
 	} // yb
 	
 	LOGMSG3("\n%i cycles (max. orbit length %i)\n",anzcycles,maxorbitlen);
+	jobsummary.anzcycles=anzcycles;
 	for(int32_t i=0;i<anzcycles;i++) {
+		if (i < MAXSUMMARYCYCLES) jobsummary.cyclelen[i]=cycles[i].len;
 		LOGMSG2("  Cycle #%i: ",i);
 		LOGMSG5("len=%i immediate RGB(%i,%i,%i) ",cycles[i].len,
 			periodpal.rgbs[cycles[i].immediateBasinColorIdx].R,
@@ -6764,7 +9027,7 @@ void periodicity(char* afn) {
 			}
 			if ( (f<0) || (f>=256) ) {
 				LOGMSG2("Periodicity. Farbfehler %i\n",f);
-				exit(99);
+				fatal_exit(99);
 			}
 			rgbz[setx]=f;
 		}
@@ -7225,7 +9488,7 @@ void periodicity(char* afn) {
 			}
 			if ( (f<0) || (f>=256) ) {
 				LOGMSG2("Periodicity point. Farbfehler %i\n",f);
-				exit(99);
+				fatal_exit(99);
 			}
 			rgbz[setx]=f;
 		}
@@ -7308,13 +9571,13 @@ int32_t* IntManager::getMemory(const int32_t aanz) {
 	) {
 		if (anzptr >= MAXPTR) {
 			LOGMSG("Error. Memory-IntManager.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		ptr[anzptr]=current=new int32_t[allocatePerBlockIdx];
 		anzptr++;
 		if (!current) {
 			LOGMSG("Error/2. Memory-IntManager.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		freeFromIdx=0;
 		allocatedIdx=allocatePerBlockIdx;
@@ -7351,13 +9614,13 @@ BYTE* ByteManager::getMemory(const int32_t aanz) {
 	) {
 		if (anzptr >= MAXPTR) {
 			LOGMSG("Error. Memory-ByteManager.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		ptr[anzptr]=current=new BYTE[allocatePerBlockIdx];
 		anzptr++;
 		if (!current) {
 			LOGMSG("Error/2. Memory-ByteManager.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		freeFromIdx=0;
 		allocatedIdx=allocatePerBlockIdx;
@@ -7394,13 +9657,13 @@ DBYTE* DByteMgr::getMemory(const int32_t aanz) {
 	) {
 		if (anzptr >= MAXPTR) {
 			LOGMSG("Error. Memory-DByteMgr.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		ptr[anzptr]=current=new DBYTE[allocatePerBlockIdx];
 		anzptr++;
 		if (!current) {
 			LOGMSG("Error/2. Memory-DByteMgr.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		freeFromIdx=0;
 		allocatedIdx=allocatePerBlockIdx;
@@ -7437,89 +9700,380 @@ int32_t getfuncidx(const char* s) {
 	return -1;
 }
 
-int32_t bitsSufficient(
-	const char* as,
-	const int32_t aRANGE,
-	const int32_t aREFINEMENT,
-	const char* aNTS
-) {
-	char rl[128];
-	char *test=new char[strlen(as)+16];
-	strcpy(test,as);
-	upper(test);
-	sprintf(rl,";R%iL%i,",aRANGE,aREFINEMENT);
-	upper(rl);
-	char *p=strstr(test,rl);
-	if (!p) {
-		delete[] test;
-		return 0;
+// struct BitPoly
+void BitPoly::setNull(void) {
+	anz=0;
+}
+
+void BitPoly::setVar(const int32_t avar) {
+	anz=1;
+	m[0].factor=1;
+	for(int32_t i=0;i<BITVAR_ANZ;i++) m[0].exponent[i]=0;
+	m[0].exponent[avar]=1;
+}
+
+void BitPoly::addMonomial(const Monomial& am) {
+	for(int32_t i=0;i<anz;i++) {
+		if (!memcmp(m[i].exponent,am.exponent,BITVAR_ANZ)) {
+			m[i].factor += am.factor;
+			return;
+		}
 	}
-	// ;R2L8,A,D,LD,F1,QD,FP,;
-	char *p2=strstr(p+1,",;");
-	if (!p2) {
-		delete[] test;
-		return 0;
+	
+	if (anz >= MAXMONOMIALS) {
+		LOGMSG("Implementation error. Too many monomials in precision analysis.\n");
+		fatal_exit(99);
 	}
-	p2[1]=0;
-	sprintf(rl,",%s,",aNTS);
-	if (strstr(p,rl)) {
-		delete[] test;
-		return 1;
+	m[anz]=am;
+	anz++;
+}
+
+// this += asign*A
+void BitPoly::add(const BitPoly& A,const int32_t asign) {
+	for(int32_t i=0;i<A.anz;i++) {
+		Monomial t=A.m[i];
+		t.factor *= asign;
+		addMonomial(t);
 	}
+}
 
-	delete[] test;
-	return 0;
+// this = A*B, this must be neither A nor B
+void BitPoly::mul(const BitPoly& A,const BitPoly& B) {
+	anz=0;
+	for(int32_t i=0;i<A.anz;i++) {
+		for(int32_t k=0;k<B.anz;k++) {
+			Monomial t;
+			t.factor=A.m[i].factor*B.m[k].factor;
+			for(int32_t v=0;v<BITVAR_ANZ;v++) {
+				t.exponent[v]=A.m[i].exponent[v]+B.m[k].exponent[v];
+			}
+			addMonomial(t);
+		}
+	}
 }
 
-int32_t testA(void) {
-	#ifdef _FPA
-	FPA two,minustwo;
-	two.set_vlong(2);
-	minustwo.set_vlong(-2);
-	if (
-		(FAKTORAre > two) ||
-		(FAKTORAre < minustwo) ||
-		(FAKTORAim > two) ||
-		(FAKTORAim < minustwo)
-	) return 0;
-	#else
+// struct BitComplex
+void BitComplex::add(const BitComplex& A) {
+	re.add(A.re,1);
+	im.add(A.im,1);
+}
+
+// this = A*B, this must be neither A nor B
+void BitComplex::mul(const BitComplex& A,const BitComplex& B) {
+	BitPoly t;
+	re.mul(A.re,B.re);
+	t.mul(A.im,B.im);
+	re.add(t,-1);
+	im.mul(A.re,B.im);
+	t.mul(A.im,B.re);
+	im.add(t,1);
+}
+
+// iteration function as exact polynomial
+void function_polynomial(const int32_t afunc,BitComplex& res) {
+	BitComplex z,c,A,t,zn;
+	z.re.setVar(BITVAR_X);
+	z.im.setVar(BITVAR_Y);
+	c.re.setVar(BITVAR_D);
+	c.im.setVar(BITVAR_E);
+	A.re.setVar(BITVAR_F);
+	A.im.setVar(BITVAR_G);
+	
+	int32_t degree=0;
+	switch (afunc) {
+		case FUNC_Z3AZC: degree=3; break;
+		case FUNC_Z4AZC: degree=4; break;
+		case FUNC_Z5AZC: degree=5; break;
+		case FUNC_Z6AZC: degree=6; break;
+		case FUNC_Z7AZC: degree=7; break;
+		case FUNC_Z8AZC: degree=8; break;
+		case FUNC_2ITZ2C: {
+			// (z^2+c)^2+c
+			t.mul(z,z);
+			t.add(c);
+			res.mul(t,t);
+			res.add(c);
+			return;
+		}
+		default: {
+			// z^2+c
+			res.mul(z,z);
+			res.add(c);
+			return;
+		}
+	} // switch
+	
+	// z^degree+A*z+c
+	zn=z;
+	for(int32_t i=1;i<degree;i++) {
+		t.mul(zn,z);
+		zn=t;
+	}
+	res.mul(A,z);
+	res.add(zn);
+	res.add(c);
+}
+
+// number of binary digits after the point, the value being
+// a multiple of 2^-BASEDENOMINATOR as all command line input
+int32_t fractional_bits(const double avalue) {
+	double w=fabs(avalue);
+	for(int32_t k=0;k<BASEDENOMINATOR;k++) {
+		if (w == floor(w)) return k;
+		w *= 2.0;
+	}
+	
+	return BASEDENOMINATOR;
+}
+
+// integer and fractional bits an exact evaluation of every monomial and
+// of their sum needs: the certificates of _bit_requirements_per_function.zip
+// computed for the current range, level and coefficients
+void bits_needed(const BitPoly& P,int32_t& aintbits,int32_t& afracbits) {
+	double bound[BITVAR_ANZ];
+	int32_t frac[BITVAR_ANZ];
+	
+	// coordinates are multiples of the pixel width, a power of 2,
+	// or of the virtual grid's subsquare width
+	bound[BITVAR_X]=bound[BITVAR_Y]=RANGE1;
+	frac[BITVAR_X]=frac[BITVAR_Y]=(int32_t)floor(0.5-log(scaleRangePerPixel_double)/log(2.0)) + _VIRTUALGRIDBITS;
+	bound[BITVAR_D]=fabs(seedC0re_double);
+	if (fabs(seedC1re_double) > bound[BITVAR_D]) bound[BITVAR_D]=fabs(seedC1re_double);
+	bound[BITVAR_E]=fabs(seedC0im_double);
+	if (fabs(seedC1im_double) > bound[BITVAR_E]) bound[BITVAR_E]=fabs(seedC1im_double);
+	bound[BITVAR_F]=fabs(FAKTORAre_double);
+	bound[BITVAR_G]=fabs(FAKTORAim_double);
+	frac[BITVAR_D]=maximumI(fractional_bits(seedC0re_double),fractional_bits(seedC1re_double));
+	frac[BITVAR_E]=maximumI(fractional_bits(seedC0im_double),fractional_bits(seedC1im_double));
+	frac[BITVAR_F]=fractional_bits(FAKTORAre_double);
+	frac[BITVAR_G]=fractional_bits(FAKTORAim_double);
+	
+	double sum=0.0;
+	afracbits=0;
+	for(int32_t i=0;i<P.anz;i++) {
+		if (P.m[i].factor == 0) continue;
+		double w=fabs( (double)P.m[i].factor );
+		int32_t fb=0;
+		for(int32_t v=0;v<BITVAR_ANZ;v++) {
+			w *= pow(bound[v],P.m[i].exponent[v]);
+			fb += frac[v]*P.m[i].exponent[v];
+		}
+		// vanishing coefficient
+		if (w <= 0.0) continue;
+		sum += w;
+		if (fb > afracbits) afracbits=fb;
+	}
+	
+	aintbits=1;
+	if (sum >= 1.0) aintbits=(int32_t)floor(log(sum)/log(2.0))+1;
+}
+
+// bits usable per number type as the certificates assume,
+// ordered by measured speed (g++ -O3 -march=native, z6azc and
+// z3azc at len=12), fastest first; F107/F161 need Munafo's
+// sources and come last
+struct NumberTypeBits {
+	char nts[4];
+	char define[16];
+	int32_t totalbits;
+	int32_t maxint,maxfrac; // fixed point
+};
+
+const int32_t NUMBERTYPEANZ=10;
+const NumberTypeBits numbertypebits[NUMBERTYPEANZ] = {
+	{ "D","_DOUBLE",52,0,0 },
+	{ "LD","_LONGDOUBLE",62,0,0 },
+	{ "DD","_DD",104,0,0 },
+	{ "X1","_FIXPOINT1",0,63,64 },
+	{ "X2","_FIXPOINT2",0,63,128 },
+	{ "X3","_FIXPOINT3",0,63,192 },
+	{ "FP","_FPA",0,31,95 },
+	{ "QD","_QUADMATH",112,0,0 },
+	{ "F1","_F107",105,0,0 },
+	{ "F6","_F161",160,0,0 }
+};
+
+int8_t numbertype_sufficient(const int32_t atype,const int32_t aintbits,const int32_t afracbits) {
+	const NumberTypeBits *t=&numbertypebits[atype];
+	if (t->totalbits > 0) return ( (aintbits+afracbits) <= t->totalbits ? 1 : 0);
+	
 	if (
-		( fabs( (double)FAKTORAre ) > 2.0 ) ||
-		( fabs( (double)FAKTORAim ) > 2.0 )
-	) return 0;
-	#endif
+		(aintbits <= t->maxint) &&
+		(afracbits <= t->maxfrac)
+	) return 1;
 	
-	return 1;
+	return 0;
 }
 
-void setfunc_and_bitprecision(const int afunc,char* afn) {
-	char tmp2[1024],tmp3[1024];
+// reports whether the compiled number type evaluates the bounding boxes
+// exactly at the current function, range, level and coefficients and
+// which type is the fastest that does. Returns 1 if NTYP is sufficient
+int8_t check_bitprecision(const int32_t afunc) {
+	BitComplex P;
+	function_polynomial(afunc,P);
+	int32_t ire,fre,iim,fim;
+	bits_needed(P.re,ire,fre);
+	bits_needed(P.im,iim,fim);
+	
+	int32_t fastest=-1;
+	int8_t ntypok=0;
+	for(int32_t t=0;t<NUMBERTYPEANZ;t++) {
+		if (
+			(numbertype_sufficient(t,ire,fre) > 0) &&
+			(numbertype_sufficient(t,iim,fim) > 0)
+		) {
+			if (fastest < 0) fastest=t;
+			if (!strcmp(numbertypebits[t].nts,NTS)) ntypok=1;
+		}
+	}
+	
+	LOGMSG5("precision needed: real %i.%i bits, imaginary %i.%i bits\n",ire,fre,iim,fim);
+	if (fastest < 0) {
+		LOGMSG("  WARNING: none of the number types is sufficient. Results cannot be trusted.\n");
+	} else {
+		if (ntypok <= 0) {
+			LOGMSG2("  WARNING: number type %s is not sufficient. Results cannot be trusted.\n",NTS);
+		}
+		if (strcmp(numbertypebits[fastest].nts,NTS)) {
+			LOGMSG3("  fastest sufficient number type: %s (compile with %s)\n",
+				numbertypebits[fastest].nts,numbertypebits[fastest].define);
+		}
+	}
 	
-	int8_t bitprecision=1; 
+	return ntypok;
+}
+
+#ifndef _FPA
+// [a0,a1]*[b0,b1]
+static inline void centred_mul(
+	NTYP& r0,NTYP& r1,
+	const NTYP& a0,const NTYP& a1,
+	const NTYP& b0,const NTYP& b1
+) {
+	NTYP p00=a0*b0;
+	NTYP p01=a0*b1;
+	NTYP p10=a1*b0;
+	NTYP p11=a1*b1;
+	r0=minimumD(p00,p01,p10,p11);
+	r1=maximumD(p00,p01,p10,p11);
+}
+
+// mean value form of f(z)=z^d+A*z+c around the lower left corner p
+// of A: with u=Re f, v=Im f and P+iQ an enclosure of f' over A
+//   u(A) in u(p) + [0,w]*P - [0,h]*Q
+//   v(A) in v(p) + [0,w]*Q + [0,h]*P
+// f' is of lower degree and multiplied by the width, so overestimation
+// is of second order. Every term has at most the degree and fractional
+// bits of the interval extension, hence is exact in the same number
+// type. The result is intersected with the interval extension fA
+void refine_bbx_centred(PlaneRect& A,PlaneRect& fA) {
+	const int32_t d=_CENTREDDEGREE;
+	NTYP zero;
+	zero=0.0;
+	NTYP are=zero,aim=zero;
+	if (_CENTREDUSEA>0) {
+		are=FAKTORAre;
+		aim=FAKTORAim;
+	}
+	
+	// p^d
+	NTYP pr=A.x0,pi=A.y0;
+	for(int32_t k=1;k<d;k++) {
+		NTYP t=pr*A.x0-pi*A.y0;
+		pi=pr*A.y0+pi*A.x0;
+		pr=t;
+	}
+	
+	// A^(d-1) by rectangular complex interval multiplication
+	NTYP zr0=A.x0,zr1=A.x1,zi0=A.y0,zi1=A.y1;
+	for(int32_t k=2;k<d;k++) {
+		NTYP rr0,rr1,ii0,ii1,ri0,ri1,ir0,ir1;
+		centred_mul(rr0,rr1,zr0,zr1,A.x0,A.x1);
+		centred_mul(ii0,ii1,zi0,zi1,A.y0,A.y1);
+		centred_mul(ri0,ri1,zr0,zr1,A.y0,A.y1);
+		centred_mul(ir0,ir1,zi0,zi1,A.x0,A.x1);
+		zr0=rr0-ii1;
+		zr1=rr1-ii0;
+		zi0=ri0+ir0;
+		zi1=ri1+ir1;
+	}
+	
+	// f'(A)=d*A^(d-1)+A
+	const NTYP P0=d*zr0+are,P1=d*zr1+are;
+	const NTYP Q0=d*zi0+aim,Q1=d*zi1+aim;
+	const NTYP w=A.x1-A.x0;
+	const NTYP h=A.y1-A.y0;
+	// [0,w]*[a0,a1]=[w*min(a0,0),w*max(a1,0)]
+	const NTYP wP0=w*minimumD(P0,zero),wP1=w*maximumD(P1,zero);
+	const NTYP wQ0=w*minimumD(Q0,zero),wQ1=w*maximumD(Q1,zero);
+	const NTYP hP0=h*minimumD(P0,zero),hP1=h*maximumD(P1,zero);
+	const NTYP hQ0=h*minimumD(Q0,zero),hQ1=h*maximumD(Q1,zero);
+	
+	const NTYP u=pr+are*A.x0-aim*A.y0;
+	const NTYP v=pi+aim*A.x0+are*A.y0;
+	
+	centredareaia += (double)((fA.x1-fA.x0)*(fA.y1-fA.y0));
+	fA.x0=maximumD(fA.x0,u+seedC0re+wP0-hQ1);
+	fA.x1=minimumD(fA.x1,u+seedC1re+wP1-hQ0);
+	fA.y0=maximumD(fA.y0,v+seedC0im+wQ0+hP0);
+	fA.y1=minimumD(fA.y1,v+seedC1im+wQ1+hP1);
+	centredarea += (double)((fA.x1-fA.x0)*(fA.y1-fA.y0));
+}
+
+void getBoundingBoxfA_centred(PlaneRect& A,PlaneRect& fA) {
+	getBoundingBoxfA_ia(A,fA);
+	refine_bbx_centred(A,fA);
+}
+
+void getBoundingBoxfA_centred_helper(
+	PlaneRect& A,PlaneRect& fA,
+	Helper* ahx,Helper* ahy
+) {
+	getBoundingBoxfA_helper_ia(A,fA,ahx,ahy);
+	refine_bbx_centred(A,fA);
+}
+#endif
+
+// puts the centred form on top of the function's interval extension
+// if BBX=CENTRED and the function is of the form z^d+A*z+c
+void set_bbx_method(const int afunc) {
+	_CENTREDDEGREE=0;
+	centredareaia=centredarea=0.0;
+	getBoundingBoxfA_ia=getBoundingBoxfA;
+	getBoundingBoxfA_helper_ia=getBoundingBoxfA_helper;
+	if (_BBXMETHOD != BBX_CENTRED) return;
 	
-	// |Creal|<=2, |Cimag|<=2
 	#ifdef _FPA
-	FPA two,minustwo;
-	two.set_vlong(2);
-	minustwo.set_vlong(-2);
-	if (
-		(seedC0re < minustwo) ||
-		(seedC0re > two) ||
-		(seedC1re < minustwo) ||
-		(seedC1re > two) ||
-		(seedC0im < minustwo) ||
-		(seedC0im > two) ||
-		(seedC1im < minustwo) ||
-		(seedC1im > two)
-	) bitprecision=0;
+	LOGMSG("centred form not implemented for FPA, interval extension is used\n");
+	return;
 	#else
-	if (
-		( fabs( (double)seedC0re ) > 2.0 ) || 
-		( fabs( (double)seedC0im ) > 2.0 ) || 
-		( fabs( (double)seedC1re ) > 2.0 ) || 
-		( fabs( (double)seedC1im ) > 2.0 ) 
-	) bitprecision=0;
-	#endif
+	_CENTREDUSEA=1;
+	switch (afunc) {
+		case FUNC_Z3AZC: _CENTREDDEGREE=3; break;
+		case FUNC_Z4AZC: _CENTREDDEGREE=4; break;
+		case FUNC_Z5AZC: _CENTREDDEGREE=5; break;
+		case FUNC_Z6AZC: _CENTREDDEGREE=6; break;
+		case FUNC_Z7AZC: _CENTREDDEGREE=7; break;
+		case FUNC_Z8AZC: _CENTREDDEGREE=8; break;
+		case FUNC_2ITZ2C: {
+			LOGMSG("centred form not implemented for 2itz2c, interval extension is used\n");
+			return;
+		}
+		default: {
+			// z2c
+			_CENTREDDEGREE=2;
+			_CENTREDUSEA=0;
+			break;
+		}
+	} // switch
+	
+	getBoundingBoxfA=getBoundingBoxfA_centred;
+	getBoundingBoxfA_helper=getBoundingBoxfA_centred_helper;
+	#endif
+}
+
+void setfunc_and_bitprecision(const int afunc,char* afn) {
+	char tmp2[1024],tmp3[1024];
 
 	switch (afunc) {
 		case FUNC_Z3AZC: {
@@ -7543,22 +10097,8 @@ void setfunc_and_bitprecision(const int afunc,char* afn) {
 				(_HELPER_Z3AZC_Ydep_ANZ >= MAXHELPERVALUES)
 			) {
 				LOGMSG("Implementation error. Too many helper value indices z3azc.\n");
-				exit(99);
+				fatal_exit(99);
 			}
-			
-			if (bitprecision>0) if (testA() <= 0) bitprecision=0;
-			
-			// real part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,D,LD,F1,QD,F6,FP,;R2L10,A,D,LD,F1,QD,F6,FP,;R2L11,A,D,LD,F1,QD,F6,FP,;R2L12,A,D,LD,F1,QD,F6,FP,;R2L13,A,D,LD,F1,QD,F6,FP,;R2L14,A,D,LD,F1,QD,F6,FP,;R2L15,A,D,LD,F1,QD,F6,FP,;R2L16,A,D,LD,F1,QD,F6,FP,;R2L17,A,D,LD,F1,QD,F6,FP,;R2L18,A,LD,F1,QD,F6,FP,;R2L19,A,LD,F1,QD,F6,FP,;R2L20,A,LD,F1,QD,F6,FP,;R2L21,A,F1,QD,F6,FP,;R2L22,A,F1,QD,F6,FP,;R2L23,A,F1,QD,F6,FP,;R2L24,A,F1,QD,F6,FP,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,D,LD,F1,QD,F6,FP,;R4L10,A,D,LD,F1,QD,F6,FP,;R4L11,A,D,LD,F1,QD,F6,FP,;R4L12,A,D,LD,F1,QD,F6,FP,;R4L13,A,D,LD,F1,QD,F6,FP,;R4L14,A,D,LD,F1,QD,F6,FP,;R4L15,A,D,LD,F1,QD,F6,FP,;R4L16,A,D,LD,F1,QD,F6,FP,;R4L17,A,D,LD,F1,QD,F6,FP,;R4L18,A,LD,F1,QD,F6,FP,;R4L19,A,LD,F1,QD,F6,FP,;R4L20,A,LD,F1,QD,F6,FP,;R4L21,A,F1,QD,F6,FP,;R4L22,A,F1,QD,F6,FP,;R4L23,A,F1,QD,F6,FP,;R4L24,A,F1,QD,F6,FP,;R8L8,A,D,LD,F1,QD,F6,FP,;R8L9,A,D,LD,F1,QD,F6,FP,;R8L10,A,D,LD,F1,QD,F6,FP,;R8L11,A,D,LD,F1,QD,F6,FP,;R8L12,A,D,LD,F1,QD,F6,FP,;R8L13,A,D,LD,F1,QD,F6,FP,;R8L14,A,D,LD,F1,QD,F6,FP,;R8L15,A,D,LD,F1,QD,F6,FP,;R8L16,A,D,LD,F1,QD,F6,FP,;R8L17,A,D,LD,F1,QD,F6,FP,;R8L18,A,LD,F1,QD,F6,FP,;R8L19,A,LD,F1,QD,F6,FP,;R8L20,A,LD,F1,QD,F6,FP,;R8L21,A,F1,QD,F6,FP,;R8L22,A,F1,QD,F6,FP,;R8L23,A,F1,QD,F6,FP,;R8L24,A,F1,QD,F6,FP,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-			
-			// imaginary part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,D,LD,F1,QD,F6,FP,;R2L10,A,D,LD,F1,QD,F6,FP,;R2L11,A,D,LD,F1,QD,F6,FP,;R2L12,A,D,LD,F1,QD,F6,FP,;R2L13,A,D,LD,F1,QD,F6,FP,;R2L14,A,D,LD,F1,QD,F6,FP,;R2L15,A,D,LD,F1,QD,F6,FP,;R2L16,A,D,LD,F1,QD,F6,FP,;R2L17,A,D,LD,F1,QD,F6,FP,;R2L18,A,LD,F1,QD,F6,FP,;R2L19,A,LD,F1,QD,F6,FP,;R2L20,A,LD,F1,QD,F6,FP,;R2L21,A,F1,QD,F6,FP,;R2L22,A,F1,QD,F6,FP,;R2L23,A,F1,QD,F6,FP,;R2L24,A,F1,QD,F6,FP,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,D,LD,F1,QD,F6,FP,;R4L10,A,D,LD,F1,QD,F6,FP,;R4L11,A,D,LD,F1,QD,F6,FP,;R4L12,A,D,LD,F1,QD,F6,FP,;R4L13,A,D,LD,F1,QD,F6,FP,;R4L14,A,D,LD,F1,QD,F6,FP,;R4L15,A,D,LD,F1,QD,F6,FP,;R4L16,A,D,LD,F1,QD,F6,FP,;R4L17,A,D,LD,F1,QD,F6,FP,;R4L18,A,LD,F1,QD,F6,FP,;R4L19,A,LD,F1,QD,F6,FP,;R4L20,A,LD,F1,QD,F6,FP,;R4L21,A,F1,QD,F6,FP,;R4L22,A,F1,QD,F6,FP,;R4L23,A,F1,QD,F6,FP,;R4L24,A,F1,QD,F6,FP,;R8L8,A,D,LD,F1,QD,F6,FP,;R8L9,A,D,LD,F1,QD,F6,FP,;R8L10,A,D,LD,F1,QD,F6,FP,;R8L11,A,D,LD,F1,QD,F6,FP,;R8L12,A,D,LD,F1,QD,F6,FP,;R8L13,A,D,LD,F1,QD,F6,FP,;R8L14,A,D,LD,F1,QD,F6,FP,;R8L15,A,D,LD,F1,QD,F6,FP,;R8L16,A,D,LD,F1,QD,F6,FP,;R8L17,A,D,LD,F1,QD,F6,FP,;R8L18,A,LD,F1,QD,F6,FP,;R8L19,A,LD,F1,QD,F6,FP,;R8L20,A,LD,F1,QD,F6,FP,;R8L21,A,F1,QD,F6,FP,;R8L22,A,F1,QD,F6,FP,;R8L23,A,F1,QD,F6,FP,;R8L24,A,F1,QD,F6,FP,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
 
 			break;
 		} 
@@ -7583,23 +10123,9 @@ void setfunc_and_bitprecision(const int afunc,char* afn) {
 				(_HELPER_Z4AZC_Ydep_ANZ >= MAXHELPERVALUES)
 			) {
 				LOGMSG("Implementation error. Too many helper value indices z4azc.\n");
-				exit(99);
+				fatal_exit(99);
 			}
 
-			if (bitprecision>0) if (testA() <= 0) bitprecision=0;
-			
-			// real part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,D,LD,F1,QD,F6,FP,;R2L10,A,D,LD,F1,QD,F6,FP,;R2L11,A,D,LD,F1,QD,F6,FP,;R2L12,A,D,LD,F1,QD,F6,FP,;R2L13,A,D,LD,F1,QD,F6,FP,;R2L14,A,LD,F1,QD,F6,FP,;R2L15,A,LD,F1,QD,F6,FP,;R2L16,A,F1,QD,F6,FP,;R2L17,A,F1,QD,F6,FP,;R2L18,A,F1,QD,F6,FP,;R2L19,A,F1,QD,F6,FP,;R2L20,A,F1,QD,F6,FP,;R2L21,A,F1,QD,F6,FP,;R2L22,A,F1,QD,F6,FP,;R2L23,A,F1,QD,F6,FP,;R2L24,A,F1,QD,F6,FP,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,D,LD,F1,QD,F6,FP,;R4L10,A,D,LD,F1,QD,F6,FP,;R4L11,A,D,LD,F1,QD,F6,FP,;R4L12,A,D,LD,F1,QD,F6,FP,;R4L13,A,D,LD,F1,QD,F6,FP,;R4L14,A,LD,F1,QD,F6,FP,;R4L15,A,LD,F1,QD,F6,FP,;R4L16,A,F1,QD,F6,FP,;R4L17,A,F1,QD,F6,FP,;R4L18,A,F1,QD,F6,FP,;R4L19,A,F1,QD,F6,FP,;R4L20,A,F1,QD,F6,FP,;R4L21,A,F1,QD,F6,FP,;R4L22,A,F1,QD,F6,FP,;R4L23,A,F1,QD,F6,FP,;R4L24,A,F1,QD,F6,FP,;R8L8,A,D,LD,F1,QD,F6,FP,;R8L9,A,D,LD,F1,QD,F6,FP,;R8L10,A,D,LD,F1,QD,F6,FP,;R8L11,A,D,LD,F1,QD,F6,FP,;R8L12,A,D,LD,F1,QD,F6,FP,;R8L13,A,D,LD,F1,QD,F6,FP,;R8L14,A,LD,F1,QD,F6,FP,;R8L15,A,LD,F1,QD,F6,FP,;R8L16,A,F1,QD,F6,FP,;R8L17,A,F1,QD,F6,FP,;R8L18,A,F1,QD,F6,FP,;R8L19,A,F1,QD,F6,FP,;R8L20,A,F1,QD,F6,FP,;R8L21,A,F1,QD,F6,FP,;R8L22,A,F1,QD,F6,FP,;R8L23,A,F1,QD,F6,FP,;R8L24,A,F1,QD,F6,FP,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-			
-			// imaginary part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,D,LD,F1,QD,F6,FP,;R2L10,A,D,LD,F1,QD,F6,FP,;R2L11,A,D,LD,F1,QD,F6,FP,;R2L12,A,D,LD,F1,QD,F6,FP,;R2L13,A,D,LD,F1,QD,F6,FP,;R2L14,A,LD,F1,QD,F6,FP,;R2L15,A,LD,F1,QD,F6,FP,;R2L16,A,F1,QD,F6,FP,;R2L17,A,F1,QD,F6,FP,;R2L18,A,F1,QD,F6,FP,;R2L19,A,F1,QD,F6,FP,;R2L20,A,F1,QD,F6,FP,;R2L21,A,F1,QD,F6,FP,;R2L22,A,F1,QD,F6,FP,;R2L23,A,F1,QD,F6,FP,;R2L24,A,F1,QD,F6,FP,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,D,LD,F1,QD,F6,FP,;R4L10,A,D,LD,F1,QD,F6,FP,;R4L11,A,D,LD,F1,QD,F6,FP,;R4L12,A,D,LD,F1,QD,F6,FP,;R4L13,A,D,LD,F1,QD,F6,FP,;R4L14,A,LD,F1,QD,F6,FP,;R4L15,A,LD,F1,QD,F6,FP,;R4L16,A,F1,QD,F6,FP,;R4L17,A,F1,QD,F6,FP,;R4L18,A,F1,QD,F6,FP,;R4L19,A,F1,QD,F6,FP,;R4L20,A,F1,QD,F6,FP,;R4L21,A,F1,QD,F6,FP,;R4L22,A,F1,QD,F6,FP,;R4L23,A,F1,QD,F6,FP,;R4L24,A,F1,QD,F6,FP,;R8L8,A,D,LD,F1,QD,F6,FP,;R8L9,A,D,LD,F1,QD,F6,FP,;R8L10,A,D,LD,F1,QD,F6,FP,;R8L11,A,D,LD,F1,QD,F6,FP,;R8L12,A,D,LD,F1,QD,F6,FP,;R8L13,A,D,LD,F1,QD,F6,FP,;R8L14,A,LD,F1,QD,F6,FP,;R8L15,A,LD,F1,QD,F6,FP,;R8L16,A,F1,QD,F6,FP,;R8L17,A,F1,QD,F6,FP,;R8L18,A,F1,QD,F6,FP,;R8L19,A,F1,QD,F6,FP,;R8L20,A,F1,QD,F6,FP,;R8L21,A,F1,QD,F6,FP,;R8L22,A,F1,QD,F6,FP,;R8L23,A,F1,QD,F6,FP,;R8L24,A,F1,QD,F6,FP,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-
 			break;
 		}
 		case FUNC_Z5AZC: {
@@ -7623,23 +10149,9 @@ void setfunc_and_bitprecision(const int afunc,char* afn) {
 				(_HELPER_Z5AZC_Ydep_ANZ >= MAXHELPERVALUES)
 			) {
 				LOGMSG("Implementation error. Too many helper value indices z5azc.\n");
-				exit(99);
+				fatal_exit(99);
 			}
 
-			if (bitprecision>0) if (testA() <= 0) bitprecision=0;
-			
-			// real part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,D,LD,F1,QD,F6,FP,;R2L10,A,D,LD,F1,QD,F6,FP,;R2L11,A,LD,F1,QD,F6,FP,;R2L12,A,LD,F1,QD,F6,FP,;R2L13,A,F1,QD,F6,FP,;R2L14,A,F1,QD,F6,FP,;R2L15,A,F1,QD,F6,FP,;R2L16,A,F1,QD,F6,FP,;R2L17,A,F1,QD,F6,FP,;R2L18,A,F1,QD,F6,FP,;R2L19,A,F1,QD,F6,FP,;R2L20,A,F1,QD,F6,FP,;R2L21,A,F1,QD,F6,FP,;R2L22,A,QD,F6,;R2L23,A,QD,F6,;R2L24,A,QD,F6,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,D,LD,F1,QD,F6,FP,;R4L10,A,D,LD,F1,QD,F6,FP,;R4L11,A,LD,F1,QD,F6,FP,;R4L12,A,LD,F1,QD,F6,FP,;R4L13,A,F1,QD,F6,FP,;R4L14,A,F1,QD,F6,FP,;R4L15,A,F1,QD,F6,FP,;R4L16,A,F1,QD,F6,FP,;R4L17,A,F1,QD,F6,FP,;R4L18,A,F1,QD,F6,FP,;R4L19,A,F1,QD,F6,FP,;R4L20,A,F1,QD,F6,FP,;R4L21,A,F1,QD,F6,FP,;R4L22,A,QD,F6,FP,;R4L23,A,QD,F6,;R4L24,A,QD,F6,;R8L8,A,D,LD,F1,QD,F6,FP,;R8L9,A,D,LD,F1,QD,F6,FP,;R8L10,A,D,LD,F1,QD,F6,FP,;R8L11,A,LD,F1,QD,F6,FP,;R8L12,A,LD,F1,QD,F6,FP,;R8L13,A,F1,QD,F6,FP,;R8L14,A,F1,QD,F6,FP,;R8L15,A,F1,QD,F6,FP,;R8L16,A,F1,QD,F6,FP,;R8L17,A,F1,QD,F6,FP,;R8L18,A,F1,QD,F6,FP,;R8L19,A,F1,QD,F6,FP,;R8L20,A,F1,QD,F6,FP,;R8L21,A,F1,QD,F6,FP,;R8L22,A,QD,F6,FP,;R8L23,A,QD,F6,FP,;R8L24,A,QD,F6,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-			
-			// imaginary part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,D,LD,F1,QD,F6,FP,;R2L10,A,D,LD,F1,QD,F6,FP,;R2L11,A,LD,F1,QD,F6,FP,;R2L12,A,LD,F1,QD,F6,FP,;R2L13,A,F1,QD,F6,FP,;R2L14,A,F1,QD,F6,FP,;R2L15,A,F1,QD,F6,FP,;R2L16,A,F1,QD,F6,FP,;R2L17,A,F1,QD,F6,FP,;R2L18,A,F1,QD,F6,FP,;R2L19,A,F1,QD,F6,FP,;R2L20,A,F1,QD,F6,FP,;R2L21,A,F1,QD,F6,FP,;R2L22,A,QD,F6,;R2L23,A,QD,F6,;R2L24,A,QD,F6,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,D,LD,F1,QD,F6,FP,;R4L10,A,D,LD,F1,QD,F6,FP,;R4L11,A,LD,F1,QD,F6,FP,;R4L12,A,LD,F1,QD,F6,FP,;R4L13,A,F1,QD,F6,FP,;R4L14,A,F1,QD,F6,FP,;R4L15,A,F1,QD,F6,FP,;R4L16,A,F1,QD,F6,FP,;R4L17,A,F1,QD,F6,FP,;R4L18,A,F1,QD,F6,FP,;R4L19,A,F1,QD,F6,FP,;R4L20,A,F1,QD,F6,FP,;R4L21,A,F1,QD,F6,FP,;R4L22,A,QD,F6,FP,;R4L23,A,QD,F6,;R4L24,A,QD,F6,;R8L8,A,D,LD,F1,QD,F6,FP,;R8L9,A,D,LD,F1,QD,F6,FP,;R8L10,A,D,LD,F1,QD,F6,FP,;R8L11,A,LD,F1,QD,F6,FP,;R8L12,A,LD,F1,QD,F6,FP,;R8L13,A,F1,QD,F6,FP,;R8L14,A,F1,QD,F6,FP,;R8L15,A,F1,QD,F6,FP,;R8L16,A,F1,QD,F6,FP,;R8L17,A,F1,QD,F6,FP,;R8L18,A,F1,QD,F6,FP,;R8L19,A,F1,QD,F6,FP,;R8L20,A,F1,QD,F6,FP,;R8L21,A,F1,QD,F6,FP,;R8L22,A,QD,F6,FP,;R8L23,A,QD,F6,FP,;R8L24,A,QD,F6,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-
 			break;
 		}
 		case FUNC_Z6AZC: {
@@ -7663,23 +10175,9 @@ void setfunc_and_bitprecision(const int afunc,char* afn) {
 				(_HELPER_Z6AZC_Ydep_ANZ >= MAXHELPERVALUES)
 			) {
 				LOGMSG("Implementation error. Too many helper value indices z6azc.\n");
-				exit(99);
+				fatal_exit(99);
 			}
 
-			if (bitprecision>0) if (testA() <= 0) bitprecision=0;
-			
-			// real part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,LD,F1,QD,F6,FP,;R2L10,A,LD,F1,QD,F6,FP,;R2L11,A,F1,QD,F6,FP,;R2L12,A,F1,QD,F6,FP,;R2L13,A,F1,QD,F6,FP,;R2L14,A,F1,QD,F6,FP,;R2L15,A,F1,QD,F6,FP,;R2L16,A,F1,QD,F6,FP,;R2L17,A,F1,QD,F6,FP,;R2L18,A,QD,F6,;R2L19,A,QD,F6,;R2L20,A,QD,F6,;R2L21,A,QD,F6,;R2L22,A,F6,;R2L23,A,F6,;R2L24,A,F6,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,LD,F1,QD,F6,FP,;R4L10,A,LD,F1,QD,F6,FP,;R4L11,A,F1,QD,F6,FP,;R4L12,A,F1,QD,F6,FP,;R4L13,A,F1,QD,F6,FP,;R4L14,A,F1,QD,F6,FP,;R4L15,A,F1,QD,F6,FP,;R4L16,A,F1,QD,F6,FP,;R4L17,A,F1,QD,F6,FP,;R4L18,A,QD,F6,FP,;R4L19,A,QD,F6,;R4L20,A,QD,F6,;R4L21,A,QD,F6,;R4L22,A,F6,;R4L23,A,F6,;R4L24,A,F6,;R8L8,A,LD,F1,QD,F6,FP,;R8L9,A,LD,F1,QD,F6,FP,;R8L10,A,LD,F1,QD,F6,FP,;R8L11,A,F1,QD,F6,FP,;R8L12,A,F1,QD,F6,FP,;R8L13,A,F1,QD,F6,FP,;R8L14,A,F1,QD,F6,FP,;R8L15,A,F1,QD,F6,FP,;R8L16,A,F1,QD,F6,FP,;R8L17,A,F1,QD,F6,FP,;R8L18,A,QD,F6,FP,;R8L19,A,QD,F6,FP,;R8L20,A,QD,F6,;R8L21,A,QD,F6,;R8L22,A,F6,;R8L23,A,F6,;R8L24,A,F6,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-			
-			// imaginary part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,LD,F1,QD,F6,FP,;R2L10,A,LD,F1,QD,F6,FP,;R2L11,A,F1,QD,F6,FP,;R2L12,A,F1,QD,F6,FP,;R2L13,A,F1,QD,F6,FP,;R2L14,A,F1,QD,F6,FP,;R2L15,A,F1,QD,F6,FP,;R2L16,A,F1,QD,F6,FP,;R2L17,A,F1,QD,F6,FP,;R2L18,A,QD,F6,;R2L19,A,QD,F6,;R2L20,A,QD,F6,;R2L21,A,QD,F6,;R2L22,A,F6,;R2L23,A,F6,;R2L24,A,F6,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,LD,F1,QD,F6,FP,;R4L10,A,LD,F1,QD,F6,FP,;R4L11,A,F1,QD,F6,FP,;R4L12,A,F1,QD,F6,FP,;R4L13,A,F1,QD,F6,FP,;R4L14,A,F1,QD,F6,FP,;R4L15,A,F1,QD,F6,FP,;R4L16,A,F1,QD,F6,FP,;R4L17,A,F1,QD,F6,FP,;R4L18,A,QD,F6,FP,;R4L19,A,QD,F6,;R4L20,A,QD,F6,;R4L21,A,QD,F6,;R4L22,A,F6,;R4L23,A,F6,;R4L24,A,F6,;R8L8,A,LD,F1,QD,F6,FP,;R8L9,A,LD,F1,QD,F6,FP,;R8L10,A,LD,F1,QD,F6,FP,;R8L11,A,F1,QD,F6,FP,;R8L12,A,F1,QD,F6,FP,;R8L13,A,F1,QD,F6,FP,;R8L14,A,F1,QD,F6,FP,;R8L15,A,F1,QD,F6,FP,;R8L16,A,F1,QD,F6,FP,;R8L17,A,F1,QD,F6,FP,;R8L18,A,QD,F6,FP,;R8L19,A,QD,F6,FP,;R8L20,A,QD,F6,;R8L21,A,QD,F6,;R8L22,A,F6,;R8L23,A,F6,;R8L24,A,F6,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-
 			break;
 		}
 		case FUNC_2ITZ2C: {
@@ -7703,7 +10201,7 @@ void setfunc_and_bitprecision(const int afunc,char* afn) {
 				(_HELPER_2ITZ2C_Ydep_ANZ >= MAXHELPERVALUES)
 			) {
 				LOGMSG("Implementation error. Too many helper value indices 2itz2c.\n");
-				exit(99);
+				fatal_exit(99);
 			}
 
 			break;
@@ -7730,23 +10228,9 @@ void setfunc_and_bitprecision(const int afunc,char* afn) {
 				(_HELPER_Z7AZC_Ydep_ANZ >= MAXHELPERVALUES)
 			) {
 				LOGMSG("Implementation error. Too many helper value indices z7azc.\n");
-				exit(99);
+				fatal_exit(99);
 			}
 
-			if (bitprecision>0) if (testA() <= 0) bitprecision=0;
-			
-			// real part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,LD,F1,QD,F6,FP,;R2L9,A,F1,QD,F6,FP,;R2L10,A,F1,QD,F6,FP,;R2L11,A,F1,QD,F6,FP,;R2L12,A,F1,QD,F6,FP,;R2L13,A,F1,QD,F6,FP,;R2L14,A,F1,QD,F6,FP,;R2L15,A,F1,QD,F6,FP,;R2L16,A,QD,F6,;R2L17,A,QD,F6,;R2L18,A,QD,F6,;R2L19,A,F6,;R2L20,A,F6,;R2L21,A,F6,;R2L22,A,F6,;R2L23,A,;R2L24,A,;R4L8,A,LD,F1,QD,F6,FP,;R4L9,A,F1,QD,F6,FP,;R4L10,A,F1,QD,F6,FP,;R4L11,A,F1,QD,F6,FP,;R4L12,A,F1,QD,F6,FP,;R4L13,A,F1,QD,F6,FP,;R4L14,A,F1,QD,F6,FP,;R4L15,A,F1,QD,F6,FP,;R4L16,A,QD,F6,FP,;R4L17,A,QD,F6,;R4L18,A,QD,F6,;R4L19,A,F6,;R4L20,A,F6,;R4L21,A,F6,;R4L22,A,F6,;R4L23,A,;R4L24,A,;R8L8,A,LD,F1,QD,F6,FP,;R8L9,A,F1,QD,F6,FP,;R8L10,A,F1,QD,F6,FP,;R8L11,A,F1,QD,F6,FP,;R8L12,A,F1,QD,F6,FP,;R8L13,A,F1,QD,F6,FP,;R8L14,A,F1,QD,F6,FP,;R8L15,A,F1,QD,F6,FP,;R8L16,A,QD,F6,FP,;R8L17,A,QD,F6,FP,;R8L18,A,QD,F6,;R8L19,A,F6,;R8L20,A,F6,;R8L21,A,F6,;R8L22,A,F6,;R8L23,A,;R8L24,A,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-			
-			// imaginary part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,LD,F1,QD,F6,FP,;R2L9,A,F1,QD,F6,FP,;R2L10,A,F1,QD,F6,FP,;R2L11,A,F1,QD,F6,FP,;R2L12,A,F1,QD,F6,FP,;R2L13,A,F1,QD,F6,FP,;R2L14,A,F1,QD,F6,FP,;R2L15,A,F1,QD,F6,FP,;R2L16,A,QD,F6,;R2L17,A,QD,F6,;R2L18,A,QD,F6,;R2L19,A,F6,;R2L20,A,F6,;R2L21,A,F6,;R2L22,A,F6,;R2L23,A,;R2L24,A,;R4L8,A,LD,F1,QD,F6,FP,;R4L9,A,F1,QD,F6,FP,;R4L10,A,F1,QD,F6,FP,;R4L11,A,F1,QD,F6,FP,;R4L12,A,F1,QD,F6,FP,;R4L13,A,F1,QD,F6,FP,;R4L14,A,F1,QD,F6,FP,;R4L15,A,F1,QD,F6,FP,;R4L16,A,QD,F6,FP,;R4L17,A,QD,F6,;R4L18,A,QD,F6,;R4L19,A,F6,;R4L20,A,F6,;R4L21,A,F6,;R4L22,A,F6,;R4L23,A,;R4L24,A,;R8L8,A,LD,F1,QD,F6,FP,;R8L9,A,F1,QD,F6,FP,;R8L10,A,F1,QD,F6,FP,;R8L11,A,F1,QD,F6,FP,;R8L12,A,F1,QD,F6,FP,;R8L13,A,F1,QD,F6,FP,;R8L14,A,F1,QD,F6,FP,;R8L15,A,F1,QD,F6,FP,;R8L16,A,QD,F6,FP,;R8L17,A,QD,F6,FP,;R8L18,A,QD,F6,;R8L19,A,F6,;R8L20,A,F6,;R8L21,A,F6,;R8L22,A,F6,;R8L23,A,;R8L24,A,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-
 			break;
 		}
 		case FUNC_Z8AZC: {
@@ -7771,23 +10255,9 @@ void setfunc_and_bitprecision(const int afunc,char* afn) {
 				(_HELPER_Z8AZC_Ydep_ANZ >= MAXHELPERVALUES)
 			) {
 				LOGMSG("Implementation error. Too many helper value indices z7azc.\n");
-				exit(99);
+				fatal_exit(99);
 			}
 
-			if (bitprecision>0) if (testA() <= 0) bitprecision=0;
-			
-			// real part
-			if (bitprecision>0) if (bitsSufficient(
-				";"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-			
-			// imaginary part
-			if (bitprecision>0) if (bitsSufficient(
-				";"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-
 			break;
 		}
 		default: {
@@ -7804,24 +10274,15 @@ void setfunc_and_bitprecision(const int afunc,char* afn) {
 				(_HELPER_Z2C_Ydep_ANZ >= MAXHELPERVALUES)
 			) {
 				LOGMSG("Implementation error. Too many helper value indices z2c.\n");
-				exit(99);
+				fatal_exit(99);
 			}
-			
-			// real part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,D,LD,F1,QD,F6,FP,;R2L10,A,D,LD,F1,QD,F6,FP,;R2L11,A,D,LD,F1,QD,F6,FP,;R2L12,A,D,LD,F1,QD,F6,FP,;R2L13,A,D,LD,F1,QD,F6,FP,;R2L14,A,D,LD,F1,QD,F6,FP,;R2L15,A,D,LD,F1,QD,F6,FP,;R2L16,A,D,LD,F1,QD,F6,FP,;R2L17,A,D,LD,F1,QD,F6,FP,;R2L18,A,D,LD,F1,QD,F6,FP,;R2L19,A,D,LD,F1,QD,F6,FP,;R2L20,A,D,LD,F1,QD,F6,FP,;R2L21,A,D,LD,F1,QD,F6,FP,;R2L22,A,D,LD,F1,QD,F6,FP,;R2L23,A,D,LD,F1,QD,F6,FP,;R2L24,A,D,LD,F1,QD,F6,FP,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,D,LD,F1,QD,F6,FP,;R4L10,A,D,LD,F1,QD,F6,FP,;R4L11,A,D,LD,F1,QD,F6,FP,;R4L12,A,D,LD,F1,QD,F6,FP,;R4L13,A,D,LD,F1,QD,F6,FP,;R4L14,A,D,LD,F1,QD,F6,FP,;R4L15,A,D,LD,F1,QD,F6,FP,;R4L16,A,D,LD,F1,QD,F6,FP,;R4L17,A,D,LD,F1,QD,F6,FP,;R4L18,A,D,LD,F1,QD,F6,FP,;R4L19,A,D,LD,F1,QD,F6,FP,;R4L20,A,D,LD,F1,QD,F6,FP,;R4L21,A,D,LD,F1,QD,F6,FP,;R4L22,A,D,LD,F1,QD,F6,FP,;R4L23,A,D,LD,F1,QD,F6,FP,;R4L24,A,D,LD,F1,QD,F6,FP,;R8L8,A,D,LD,F1,QD,F6,FP,;R8L9,A,D,LD,F1,QD,F6,FP,;R8L10,A,D,LD,F1,QD,F6,FP,;R8L11,A,D,LD,F1,QD,F6,FP,;R8L12,A,D,LD,F1,QD,F6,FP,;R8L13,A,D,LD,F1,QD,F6,FP,;R8L14,A,D,LD,F1,QD,F6,FP,;R8L15,A,D,LD,F1,QD,F6,FP,;R8L16,A,D,LD,F1,QD,F6,FP,;R8L17,A,D,LD,F1,QD,F6,FP,;R8L18,A,D,LD,F1,QD,F6,FP,;R8L19,A,D,LD,F1,QD,F6,FP,;R8L20,A,D,LD,F1,QD,F6,FP,;R8L21,A,D,LD,F1,QD,F6,FP,;R8L22,A,D,LD,F1,QD,F6,FP,;R8L23,A,D,LD,F1,QD,F6,FP,;R8L24,A,D,LD,F1,QD,F6,FP,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
-			
-			// imaginary part
-			if (bitprecision>0) if (bitsSufficient(
-				";R2L8,A,D,LD,F1,QD,F6,FP,;R2L9,A,D,LD,F1,QD,F6,FP,;R2L10,A,D,LD,F1,QD,F6,FP,;R2L11,A,D,LD,F1,QD,F6,FP,;R2L12,A,D,LD,F1,QD,F6,FP,;R2L13,A,D,LD,F1,QD,F6,FP,;R2L14,A,D,LD,F1,QD,F6,FP,;R2L15,A,D,LD,F1,QD,F6,FP,;R2L16,A,D,LD,F1,QD,F6,FP,;R2L17,A,D,LD,F1,QD,F6,FP,;R2L18,A,D,LD,F1,QD,F6,FP,;R2L19,A,D,LD,F1,QD,F6,FP,;R2L20,A,D,LD,F1,QD,F6,FP,;R2L21,A,D,LD,F1,QD,F6,FP,;R2L22,A,D,LD,F1,QD,F6,FP,;R2L23,A,D,LD,F1,QD,F6,FP,;R2L24,A,D,LD,F1,QD,F6,FP,;R4L8,A,D,LD,F1,QD,F6,FP,;R4L9,A,D,LD,F1,QD,F6,FP,;R4L10,A,D,LD,F1,QD,F6,FP,;R4L11,A,D,LD,F1,QD,F6,FP,;R4L12,A,D,LD,F1,QD,F6,FP,;R4L13,A,D,LD,F1,QD,F6,FP,;R4L14,A,D,LD,F1,QD,F6,FP,;R4L15,A,D,LD,F1,QD,F6,FP,;R4L16,A,D,LD,F1,QD,F6,FP,;R4L17,A,D,LD,F1,QD,F6,FP,;R4L18,A,D,LD,F1,QD,F6,FP,;R4L19,A,D,LD,F1,QD,F6,FP,;R4L20,A,D,LD,F1,QD,F6,FP,;R4L21,A,D,LD,F1,QD,F6,FP,;R4L22,A,D,LD,F1,QD,F6,FP,;R4L23,A,D,LD,F1,QD,F6,FP,;R4L24,A,D,LD,F1,QD,F6,FP,;R8L8,A,D,LD,F1,QD,F6,FP,;R8L9,A,D,LD,F1,QD,F6,FP,;R8L10,A,D,LD,F1,QD,F6,FP,;R8L11,A,D,LD,F1,QD,F6,FP,;R8L12,A,D,LD,F1,QD,F6,FP,;R8L13,A,D,LD,F1,QD,F6,FP,;R8L14,A,D,LD,F1,QD,F6,FP,;R8L15,A,D,LD,F1,QD,F6,FP,;R8L16,A,D,LD,F1,QD,F6,FP,;R8L17,A,D,LD,F1,QD,F6,FP,;R8L18,A,D,LD,F1,QD,F6,FP,;R8L19,A,D,LD,F1,QD,F6,FP,;R8L20,A,D,LD,F1,QD,F6,FP,;R8L21,A,D,LD,F1,QD,F6,FP,;R8L22,A,D,LD,F1,QD,F6,FP,;R8L23,A,D,LD,F1,QD,F6,FP,;R8L24,A,D,LD,F1,QD,F6,FP,;"
-				,RANGE1,REFINEMENTLEVEL,NTS
-			) <= 0) bitprecision=0;
 
 			break;
 		}
 	} // switch
+	
+	set_bbx_method(afunc);
+	check_bitprecision(afunc);
 }
 
 // struct ListeFIFO
@@ -7854,7 +10315,7 @@ char ListeFIFO::write(const int32_t x,const int32_t y) {
 		werte=new Int2[allokiereAmStueck];
 		if (!werte) {
 			LOGMSG("ListeFIFO: No memory\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		next_writepos=0;
 	}
@@ -7902,7 +10363,7 @@ char ListeDFS::write(const int32_t x,const int32_t y,const DBYTE t) {
 		werte=new DFSPunkt[allokiereAmStueck];
 		if (!werte) {
 			LOGMSG("ListeDFS: No memory\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		anz=0;
 	}
@@ -7925,6 +10386,7 @@ ArrayDDByteManager::ArrayDDByteManager() {
 	allokierteIdx=0;
 	freiAbIdx=-1;
 	anzptr=0;
+	reuseidx=0;
 	double d=CHUNKSIZE; d /= sizeof(DDBYTE);
 	allokierePerBlockIdx=(int32_t)floor(d);
 }
@@ -7938,18 +10400,24 @@ ArrayDDByteManager::~ArrayDDByteManager() {
 PDDBYTE ArrayDDByteManager::getMemory(const int aanz) {
 	if (anzptr >= (MAXPTR-8)) {
 		LOGMSG("ArrayDDByteManager:: Zu wenig Speicher\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	if (
 		(!current) ||
 		((freiAbIdx + aanz + 2) >= allokierteIdx)
 	) {
-		printf("x");
-		ptr[anzptr]=current=new DDBYTE[allokierePerBlockIdx];
-		anzptr++;
-		if (!current) {
-			printf("Memory-Fehler. ArrayDDByteManager.\n");
-			exit(99);
+		if (reuseidx < anzptr) {
+			current=ptr[reuseidx];
+			reuseidx++;
+		} else {
+			printf("x");
+			ptr[anzptr]=current=new DDBYTE[allokierePerBlockIdx];
+			anzptr++;
+			reuseidx=anzptr;
+			if (!current) {
+				printf("Memory-Fehler. ArrayDDByteManager.\n");
+				fatal_exit(99);
+			}
 		}
 		freiAbIdx=0;
 		allokierteIdx=allokierePerBlockIdx;
@@ -7961,11 +10429,47 @@ PDDBYTE ArrayDDByteManager::getMemory(const int aanz) {
 	return p;
 }
 
+// memory handed out so far is considered free, chunks are kept
+void ArrayDDByteManager::rewind(void) {
+	current=NULL;
+	freiAbIdx=-1;
+	allokierteIdx=0;
+	reuseidx=0;
+}
+
+// index of the chunk holding ap, -1 if none
+int32_t ArrayDDByteManager::chunkOf(const DDBYTE* ap) {
+	for(int32_t i=0;i<anzptr;i++) {
+		if ( (ap >= ptr[i]) && (ap < (ptr[i]+allokierePerBlockIdx)) ) return i;
+	}
+	
+	return -1;
+}
+
+// chunk achunk becomes the current one with integers from afrei on
+// free, all chunks after it are given back to the operating system
+// returns bytes released
+int64_t ArrayDDByteManager::releaseAfter(const int32_t achunk,const int32_t afrei) {
+	int64_t released=0;
+	for(int32_t i=achunk+1;i<anzptr;i++) {
+		delete[] ptr[i];
+		ptr[i]=NULL;
+		released += ((int64_t)allokierePerBlockIdx*sizeof(DDBYTE));
+	}
+	anzptr=achunk+1;
+	reuseidx=anzptr;
+	current=ptr[achunk];
+	freiAbIdx=afrei;
+	allokierteIdx=allokierePerBlockIdx;
+	
+	return released;
+}
+
 // RefPointArray
 void RefPointArray::addRefPoint(const int32_t ax,const int32_t ay,const int32_t ablobid) {
 	if (!listY[ay].points) {
 		LOGMSG2("Implementation error. RefPointArray::addRefPoint not allocated at y=%i\n",ay);
-		exit(99);
+		fatal_exit(99);
 	}
 	listY[ay].addXB(ax,ablobid);
 }
@@ -7973,7 +10477,7 @@ void RefPointArray::addRefPoint(const int32_t ax,const int32_t ay,const int32_t
 RefPoint* RefPointArray::getRefPtr(const int32_t ax,const int32_t ay) {
 	if (!listY[ay].points) {
 		LOGMSG2("Error. getBloId of non-refpoint-row %i\n",ay);
-		exit(99);
+		fatal_exit(99);
 	}
 	
 	return listY[ay].getRefPtr(ax);
@@ -8006,7 +10510,7 @@ Int2Manager::~Int2Manager() {
 PInt2 Int2Manager::getMemory(const int aanz) {
 	if (anzptr >= MAXPTR) {
 		LOGMSG("Int2Manager:: Memory error.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	if (
 		(!current) ||
@@ -8016,7 +10520,7 @@ PInt2 Int2Manager::getMemory(const int aanz) {
 		anzptr++;
 		if (!current) {
 			printf("Memory-Fehler. Int2Manager.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		freiAbIdx=0;
 		allokierteIdx=allokierePerBlockIdx;
@@ -8046,7 +10550,7 @@ ScreenRectManager::~ScreenRectManager() {
 ScreenRect* ScreenRectManager::getMemory(const int aanz) {
 	if (anzptr >= MAXPTR) {
 		LOGMSG("ScreenRectManagerManager:: Memory error.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	if (
 		(!current) ||
@@ -8056,7 +10560,7 @@ ScreenRect* ScreenRectManager::getMemory(const int aanz) {
 		anzptr++;
 		if (!current) {
 			printf("Memory-Fehler. ScreenRectManager.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		freiAbIdx=0;
 		allokierteIdx=allokierePerBlockIdx;
@@ -8067,6 +10571,95 @@ ScreenRect* ScreenRectManager::getMemory(const int aanz) {
 	return p;
 }
 
+// struct GraySpanManager
+GraySpanManager::GraySpanManager() {
+	current=NULL;
+	allokierteIdx=0;
+	freiAbIdx=-1;
+	anzptr=0;
+	// span tables are small compared to the rows
+	double d=(CHUNKSIZE >> 4); d /= sizeof(GraySpan);
+	allokierePerBlockIdx=(int32_t)floor(d);
+}
+
+GraySpanManager::~GraySpanManager() {
+	for(int32_t i=0;i<anzptr;i++) {
+		delete[] ptr[i];
+	}
+}
+
+GraySpan* GraySpanManager::getMemory(const int aanz) {
+	if (anzptr >= MAXPTR) {
+		LOGMSG("GraySpanManager:: Memory error.\n");
+		fatal_exit(99);
+	}
+	if (
+		(!current) ||
+		((freiAbIdx + aanz + 2) >= allokierteIdx)
+	) {
+		ptr[anzptr]=current=new GraySpan[allokierePerBlockIdx];
+		anzptr++;
+		if (!current) {
+			printf("Memory-Fehler. GraySpanManager.\n");
+			fatal_exit(99);
+		}
+		freiAbIdx=0;
+		allokierteIdx=allokierePerBlockIdx;
+	}
+	
+	GraySpan* p=&current[freiAbIdx];
+	freiAbIdx += aanz;
+	return p;
+}
+
+// struct Gray_in_row
+void Gray_in_row::setEmpty(void) {
+	g0=SCREENWIDTH;
+	g1=0;
+	mem0=SCREENWIDTH >> 4;
+	mem1=0;
+	anzspans=spanmemused=0;
+	spans=NULL;
+	settled=0;
+}
+
+// enclosement from the first and last span
+void Gray_in_row::setEnclosement(void) {
+	mem0=spans[0].mem0;
+	mem1=spans[anzspans-1].mem1;
+	g0=mem0 << 4;
+	g1=((mem1+1) << 4)-1;
+}
+
+// number of 32bit integers allocated for the spans
+int32_t Gray_in_row::words(void) {
+	if (anzspans <= 0) return 0;
+	
+	return spans[anzspans-1].offset + spans[anzspans-1].mem1-spans[anzspans-1].mem0+1;
+}
+
+// does one of the spans overlap with pixels ax0..ax1
+int8_t Gray_in_row::overlaps(const int32_t ax0,const int32_t ax1) {
+	if ( (ax1 < g0) || (ax0 > g1) ) return 0;
+	
+	const int32_t sp=firstSpan(ax0 >> 4);
+	if ( (spans[sp].mem1 >= (ax0 >> 4)) && (spans[sp].mem0 <= (ax1 >> 4)) ) return 1;
+	
+	return 0;
+}
+
+// index of the first span ending at or after integer amem
+// (the last span if there is none)
+int32_t Gray_in_row::firstSpan(const int32_t amem) const {
+	int32_t left=0,right=anzspans-1;
+	while (left < right) {
+		int32_t m=(left+right) >> 1;
+		if (spans[m].mem1 < amem) left=m+1; else right=m;
+	}
+	
+	return left;
+}
+
 // struct RefPointManager
 RefPointManager::RefPointManager() {
 	current=NULL;
@@ -8086,7 +10679,7 @@ RefPointManager::~RefPointManager() {
 RefPoint* RefPointManager::getMemory(const int aanz) {
 	if (anzptr >= MAXPTR) {
 		LOGMSG("RefPointManager:: Memory error.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	if (
 		(!current) ||
@@ -8096,7 +10689,7 @@ RefPoint* RefPointManager::getMemory(const int aanz) {
 		anzptr++;
 		if (!current) {
 			printf("Memory-Fehler. RefPointManager.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		freiAbIdx=0;
 		allokierteIdx=allokierePerBlockIdx;
@@ -8113,6 +10706,7 @@ HelperManager::HelperManager() {
 	allokierteIdx=0;
 	freiAbIdx=-1;
 	anzptr=0;
+	reuseidx=0;
 	double d=CHUNKSIZE; d /= sizeof(Helper);
 	allokierePerBlockIdx=(int32_t)floor(d);
 }
@@ -8126,17 +10720,23 @@ HelperManager::~HelperManager() {
 PHelper HelperManager::getMemory(const int aanz) {
 	if (anzptr >= MAXPTR) {
 		LOGMSG("HelperManager:: Memory error.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	if (
 		(!current) ||
 		((freiAbIdx + aanz + 2) >= allokierteIdx)
 	) {
-		ptr[anzptr]=current=new Helper[allokierePerBlockIdx];
-		anzptr++;
-		if (!current) {
-			printf("Memory-error. HelperManager.\n");
-			exit(99);
+		if (reuseidx < anzptr) {
+			current=ptr[reuseidx];
+			reuseidx++;
+		} else {
+			ptr[anzptr]=current=new Helper[allokierePerBlockIdx];
+			anzptr++;
+			reuseidx=anzptr;
+			if (!current) {
+				printf("Memory-error. HelperManager.\n");
+				fatal_exit(99);
+			}
 		}
 		freiAbIdx=0;
 		allokierteIdx=allokierePerBlockIdx;
@@ -8148,6 +10748,13 @@ PHelper HelperManager::getMemory(const int aanz) {
 	return p;
 }
 
+void HelperManager::rewind(void) {
+	current=NULL;
+	freiAbIdx=-1;
+	allokierteIdx=0;
+	reuseidx=0;
+}
+
 // struct Helper_doublemanager
 Helper_doubleManager::Helper_doubleManager() {
 	current=NULL;
@@ -8167,7 +10774,7 @@ Helper_doubleManager::~Helper_doubleManager() {
 PHelper_double Helper_doubleManager::getMemory(const int aanz) {
 	if (anzptr >= MAXPTR) {
 		LOGMSG("HelperManager_double:: Memory error.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	if (
 		(!current) ||
@@ -8177,7 +10784,7 @@ PHelper_double Helper_doubleManager::getMemory(const int aanz) {
 		anzptr++;
 		if (!current) {
 			printf("Memory-error. HelperManager_double.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		freiAbIdx=0;
 		allokierteIdx=allokierePerBlockIdx;
@@ -8745,7 +11352,7 @@ inline void FPA_mul_ZAB(FPA& erg,const FPA term1,const FPA term2) {
 	{\
 		LOGMSG("Implementation error. Precision FPA not sufficient in mul\n");\
 		LOGMSG2("%s",TT);\
-		exit(99);\
+		fatal_exit(99);\
 	}
 
 	// w.a can != 0 
@@ -8845,7 +11452,7 @@ inline void FPA_mul_ZAB(FPA& erg,const FPA term1,const FPA term2) {
 		w.a=tmp & MAXDDBYTE;
 		if ( (tmp >> 32) != 0) {
 			LOGMSG("Overflow FPA mul.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		FPA_add_ZAB(erg,erg,w);
 	}
@@ -8872,7 +11479,7 @@ inline void FPA_mul_ZAuvlong(FPA& erg,const FPA term,const uint64_t intmul) {
 	
 	if (w > MAXDDBYTE) {
 		LOGMSG("mul_zap out of range\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	erg.a=(w & MAXDDBYTE);
 	if (intmul<0) erg.vorz=-term.vorz;
@@ -8936,7 +11543,7 @@ inline void FPA::squareTo(FPA& erg) {
 	{\
 		LOGMSG("Implementation error. Precision FPA not sufficient in mul\n");\
 		LOGMSG2("%s",TT);\
-		exit(99);\
+		fatal_exit(99);\
 	}
 	
 	FPA w;
@@ -9152,7 +11759,7 @@ inline void FPA_mul_ZAB(FPA& erg,FPA* term1,FPA* term2) {
 	{\
 		LOGMSG("Implementation error. Precision FPA not sufficient in mul\n");\
 		LOGMSG2("%s",TT);\
-		exit(99);\
+		fatal_exit(99);\
 	}
 
 	// w.a can != 0 
@@ -9252,7 +11859,7 @@ inline void FPA_mul_ZAB(FPA& erg,FPA* term1,FPA* term2) {
 		w.a=tmp & MAXDDBYTE;
 		if ( (tmp >> 32) != 0) {
 			LOGMSG("Overflow FPA mul.\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		FPA_add_ZAB(erg,erg,w);
 	}
@@ -9289,7 +11896,7 @@ void FPA::shiftLeft(const int32_t bits) {
 	if ((tmpa >> 32) != 0) {
 		// overflow
 		LOGMSG("Implementation error. Shift-FPA Left overflow.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	
 	checkNull();
@@ -9303,7 +11910,7 @@ void FPA::shiftRight(const int32_t bits) {
 	if (bits==0) return; // nothing
 	if ((bits<0) || (bits > 16)) {
 		LOGMSG2("Error. shiftRight. Bit %i not implemented.\n",bits);
-		exit(99);
+		fatal_exit(99);
 	}
 	
 	uint32_t tmpa=(a & power2[bits]) << (32-bits);
@@ -9320,7 +11927,7 @@ void FPA::shiftRight(const int32_t bits) {
 		LOGMSG2("Error. Underflow FPA: %i\n",tmpd);
 		char tt[2048];
 		LOGMSG2("Result: %s\n",str(tt));
-		exit(99);
+		fatal_exit(99);
 	}
 
 	checkNull();
@@ -9400,7 +12007,7 @@ void FPA::set_double32(const double avalue) {
 		(vl < (-(int64_t)MAXDDBYTE) )
 	) {
 		printf("setdouble32 out of range. FAP %I64d\n",vl);
-		exit(99);
+		fatal_exit(99);
 	}
 	
 	a=(vl & MAXDDBYTE);
@@ -9440,7 +12047,7 @@ void FPA::set_vlong(const int64_t avalue) {
 		
 		if (wert > MAXDDBYTE) {
 			printf("out of range. setvlong\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		
 		a=wert & MAXDDBYTE;
@@ -9470,7 +12077,7 @@ inline void FPA_add_abs_ZAB(FPA& erg,const FPA term1,const FPA term2) {
 		erg.a=(sumaa & MAXDDBYTE);
 		if ((sumaa >> 32) != 0) {
 			LOGMSG("Overflow add_abs_ZAB\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		erg.checkNull();
 	}
@@ -9498,7 +12105,7 @@ inline void FPA_add_abs_ZAB(FPA& erg,FPA* term1,FPA* term2) {
 		erg.a=(sumaa & MAXDDBYTE);
 		if ((sumaa >> 32) != 0) {
 			LOGMSG("Overflow add_abs_ZAB\n");
-			exit(99);
+			fatal_exit(99);
 		}
 		erg.checkNull();
 	}
@@ -9514,7 +12121,7 @@ inline void FPA_sub_abs_ovgl_ZAB(FPA& erg,const FPA term1,const FPA term2) {
 		else {
 			// Fehler
 			LOGMSG("sub_abs_vgl out of range\n");
-			exit(99);
+			fatal_exit(99);
 		}
 	} else if (term2.vorz==0) {
 		erg.copyFrom(term1);
@@ -9555,7 +12162,7 @@ inline void FPA_sub_abs_ovgl_ZAB(FPA& erg,const FPA term1,const FPA term2) {
 
 	if (w < 0) {
 		printf("sub_ovgl: out of rnage\n");
-		exit(99);
+		fatal_exit(99);
 		erg.a=(w & MAXDDBYTE);	
 	} else {
 		erg.a=(w & MAXDDBYTE);	
@@ -9580,7 +12187,7 @@ inline void FPA_sub_abs_ovgl_ZAB(FPA& erg,FPA* term1,FPA* term2) {
 		else {
 			// Fehler
 			LOGMSG("sub_abs_vgl out of range\n");
-			exit(99);
+			fatal_exit(99);
 		}
 	} else if (term2->vorz==0) {
 		erg.copyFrom(term1);
@@ -9621,7 +12228,7 @@ inline void FPA_sub_abs_ovgl_ZAB(FPA& erg,FPA* term1,FPA* term2) {
 
 	if (w < 0) {
 		printf("sub_ovgl: out of rnage\n");
-		exit(99);
+		fatal_exit(99);
 		erg.a=(w & MAXDDBYTE);	
 	} else {
 		erg.a=(w & MAXDDBYTE);	
@@ -9740,6 +12347,147 @@ inline void	minimaxF107ABCD(Pf107& mi,Pf107& ma,
 }
 #endif
 
+#ifdef _DD
+// error-free transformations: s+e == a+b exactly
+#define TWOSUM(S,E,A,B) \
+{\
+	S=(A)+(B);\
+	double bb=S-(A);\
+	E=((A)-(S-bb))+((B)-bb);\
+}
+
+// needs |A| >= |B|
+#define QUICKTWOSUM(S,E,A,B) \
+{\
+	S=(A)+(B);\
+	E=(B)-(S-(A));\
+}
+
+DD::DD() {
+	// uninitialized
+}
+
+DD::DD(const double a) {
+	hi=a;
+	lo=0.0;
+}
+
+DD::DD(const int a) {
+	hi=a;
+	lo=0.0;
+}
+
+DD::operator double() const {
+	return hi+lo;
+}
+
+inline DD operator+(const DD& a,const DD& b) {
+	double s,e,t,f;
+	TWOSUM(s,e,a.hi,b.hi)
+	TWOSUM(t,f,a.lo,b.lo)
+	e += t;
+	double s2,e2;
+	TWOSUM(s2,e2,s,e)
+	e2 += f;
+	DD r;
+	TWOSUM(r.hi,r.lo,s2,e2)
+	
+	return r;
+}
+
+inline DD operator-(const DD& a) {
+	DD r;
+	r.hi=-a.hi;
+	r.lo=-a.lo;
+	
+	return r;
+}
+
+inline DD operator-(const DD& a,const DD& b) {
+	return a+(-b);
+}
+
+// if the product fits into 104 bits, one factor fits into a double
+// (lo==0) and the other lo-product is exact
+inline DD operator*(const DD& a,const DD& b) {
+	double p=a.hi*b.hi;
+	double e=fma(a.hi,b.hi,-p);
+	e += a.hi*b.lo + a.lo*b.hi;
+	DD r;
+	QUICKTWOSUM(r.hi,r.lo,p,e)
+	
+	return r;
+}
+
+inline DD operator*(const int a,const DD& b) {
+	DD w=a;
+	
+	return w*b;
+}
+
+// hi is the rounded value, so comparing is lexicographic
+inline bool operator<(const DD& a,const DD& b) {
+	return ( (a.hi < b.hi) || ( (a.hi == b.hi) && (a.lo < b.lo) ) );
+}
+
+inline bool operator>(const DD& a,const DD& b) {
+	return ( (a.hi > b.hi) || ( (a.hi == b.hi) && (a.lo > b.lo) ) );
+}
+
+inline bool operator<=(const DD& a,const DD& b) {
+	return !(a > b);
+}
+
+inline bool operator>=(const DD& a,const DD& b) {
+	return !(a < b);
+}
+
+inline bool operator==(const DD& a,const DD& b) {
+	return ( (a.hi == b.hi) && (a.lo == b.lo) );
+}
+
+inline bool operator!=(const DD& a,const DD& b) {
+	return ( (a.hi != b.hi) || (a.lo != b.lo) );
+}
+
+inline void minimaxDDAB(DD& mi,DD& ma,const DD& a,const DD& b) {
+	if (a < b) {
+		mi=a; ma=b;
+	} else {
+		mi=b; ma=a;
+	}
+}
+
+inline void minimaxDDABCD(DD& mi,DD& ma,
+	const DD& a,const DD& b,
+	const DD& c,const DD& d
+) {
+	const DD *miab,*maab,*micd,*macd;
+	if (a < b) {
+		miab=&a; maab=&b;
+	} else {
+		miab=&b; maab=&a;
+	}
+	if (c < d) {
+		micd=&c; macd=&d;
+	} else {
+		micd=&d; macd=&c;
+	}
+	
+	if ((*miab) < (*micd)) mi=*miab; else mi=*micd;
+	if ((*maab) > (*macd)) ma=*maab; else ma=*macd;
+}
+
+// value below 2^52: if hi is not an integer, lo cannot
+// reach the next integer
+inline double floorDD(const DD& a) {
+	double f=floor(a.hi);
+	if (f == a.hi) f += floor(a.lo);
+	
+	return f;
+}
+#endif
+
 inline void minimaxdABCD(double& mi,double& ma,
 	const double a,const double b,
 	const double c,const double d
@@ -9922,7 +12670,7 @@ int32_t getPower2Exponent(const uint64_t aw) {
 	
 	if (exponent<0) {
 		LOGMSG("Error. Range must be a power of 2.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	
 	return exponent;
@@ -9949,82 +12697,154 @@ double specialFloor161(const f161_o a) {
 
 void freeRevCGMem(void) {
 	if (parentmgr) {
-		delete parentmgr;
-		parentmgr=NULL;
+		if (activeengine) parentmgr->rewind();
+		else {
+			delete parentmgr;
+			parentmgr=NULL;
+		}
 	}
 	
-	if (data5->revcgYX) {
-		delete[] data5->revcgYX;
-		data5->revcgYX=NULL;
+	if (data5->revcgoffset) {
+		delete[] data5->revcgoffset;
+		data5->revcgoffset=NULL;
+	}
+	if (data5->revcgparents) {
+		delete[] data5->revcgparents;
+		data5->revcgparents=NULL;
+	}
+	if (data5->revcgtovisit) {
+		delete[] data5->revcgtovisit;
+		data5->revcgtovisit=NULL;
+	}
+	if (data5->revcgcontainsgray) {
+		delete[] data5->revcgcontainsgray;
+		data5->revcgcontainsgray=NULL;
+	}
+	if (data5->revcgimage) {
+		delete[] data5->revcgimage;
+		data5->revcgimage=NULL;
 	}
 }
 
-#define CALCSHRINKAGE \
-{\
-	shrinkage=0;\
-	int32_t touchesborder=0;\
-		\
-	for(int32_t yk=0;yk<split;yk++) {\
-		Aklein.y0=A.y0 + yk*scale2;\
-		Aklein.y1=Aklein.y0 + scale2;\
-		\
-		for(int32_t xk=0;xk<split;xk++) {\
-			Aklein.x0=A.x0 + xk*scale2;\
-			Aklein.x1=Aklein.x0 + scale2;\
-			\
-			getBoundingBoxfA(Aklein,bbxfAklein);\
-			\
-			if (bbxfAklein.x0 < tight.x0) {\
-				tight.x0=bbxfAklein.x0;\
-				if (tight.x0 <= bbxfA.x0) {\
-					touchesborder=1;\
-					break;\
-				}\
-			}\
-			if (bbxfAklein.x1 > tight.x1) {\
-				tight.x1=bbxfAklein.x1;\
-				if (tight.x1 >= bbxfA.x1) {\
-					touchesborder=1;\
-					break;\
-				}\
-			}\
-			if (bbxfAklein.y0 < tight.y0) {\
-				tight.y0=bbxfAklein.y0;\
-				if (tight.y0 <= bbxfA.y0) {\
-					touchesborder=1;\
-					break;\
-				}\
-			}\
-			if (bbxfAklein.y1 > tight.y1) {\
-				tight.y1=bbxfAklein.y1;\
-				if (tight.y1 >= bbxfA.y1) {\
-					touchesborder=1;\
-					break;\
-				}\
-			}\
-		}\
-		\
-		if (touchesborder>0) break;\
-	}\
-	\
-	if (touchesborder<=0) {\
-		ScreenRect scr;\
-		scr.x0=scrcoord_as_lowerleft(bbxfA.x0);\
-		scr.x1=scrcoord_as_lowerleft(bbxfA.x1);\
-		scr.y0=scrcoord_as_lowerleft(bbxfA.y0);\
-		scr.y1=scrcoord_as_lowerleft(bbxfA.y1);\
-		\
-		ScreenRect delta;\
-		delta.x0=scrcoord_as_lowerleft(tight.x0) - scr.x0;\
-		delta.x1=scr.x1 - scrcoord_as_lowerleft(tight.x1);\
-		delta.y0=scrcoord_as_lowerleft(tight.y0) - scr.y0;\
-		delta.y1=scr.y1 - scrcoord_as_lowerleft(tight.y1);\
-		\
-		shrinkage=minimumI(\
-			delta.x0,delta.x1,delta.y0,delta.y1\
-		);\
-	}\
+#ifndef _FPA
+// union of the bounding boxes of the split x split subsquares of A
+// (split=2^_VIRTUALGRIDBITS, width ascale each). It encloses f(A) and
+// lies within bbxfA. Returns the number of pixel rows and columns
+// it saves compared to bbxfA
+int32_t calc_shrinkage(
+	const PlaneRect& A,const PlaneRect& bbxfA,
+	const NTYP& ascale,PlaneRect& tight
+) {
+	const int32_t split=(1 << _VIRTUALGRIDBITS);
+	PlaneRect Aklein,bbxfAklein;
+	// no side can be tightened any more
+	int8_t touches=0;
+	
+	tight.x0=bbxfA.x1;
+	tight.x1=bbxfA.x0;
+	tight.y0=bbxfA.y1;
+	tight.y1=bbxfA.y0;
+	
+	for(int32_t yk=0;yk<split;yk++) {
+		Aklein.y0=A.y0 + yk*ascale;
+		Aklein.y1=Aklein.y0 + ascale;
+		
+		for(int32_t xk=0;xk<split;xk++) {
+			Aklein.x0=A.x0 + xk*ascale;
+			Aklein.x1=Aklein.x0 + ascale;
+			
+			getBoundingBoxfA(Aklein,bbxfAklein);
+			
+			if (bbxfAklein.x0 < tight.x0) {
+				tight.x0=bbxfAklein.x0;
+				if (tight.x0 <= bbxfA.x0) touches |= 0b0001;
+			}
+			if (bbxfAklein.x1 > tight.x1) {
+				tight.x1=bbxfAklein.x1;
+				if (tight.x1 >= bbxfA.x1) touches |= 0b0010;
+			}
+			if (bbxfAklein.y0 < tight.y0) {
+				tight.y0=bbxfAklein.y0;
+				if (tight.y0 <= bbxfA.y0) touches |= 0b0100;
+			}
+			if (bbxfAklein.y1 > tight.y1) {
+				tight.y1=bbxfAklein.y1;
+				if (tight.y1 >= bbxfA.y1) touches |= 0b1000;
+			}
+			
+			if (touches == 0b1111) {
+				tight=bbxfA;
+				return 0;
+			}
+		}
+	}
+	
+	// intersection with bbxfA, as the subsquares' boxes
+	// might be computed differently
+	tight.x0=maximumD(tight.x0,bbxfA.x0);
+	tight.x1=minimumD(tight.x1,bbxfA.x1);
+	tight.y0=maximumD(tight.y0,bbxfA.y0);
+	tight.y1=minimumD(tight.y1,bbxfA.y1);
+	
+	return 
+		(scrcoord_as_lowerleft(tight.x0) - scrcoord_as_lowerleft(bbxfA.x0)) +
+		(scrcoord_as_lowerleft(bbxfA.x1) - scrcoord_as_lowerleft(tight.x1)) +
+		(scrcoord_as_lowerleft(tight.y0) - scrcoord_as_lowerleft(bbxfA.y0)) +
+		(scrcoord_as_lowerleft(bbxfA.y1) - scrcoord_as_lowerleft(tight.y1));
+}
+
+// 32-bit integers a scan of the bounding box's screen rectangle reads
+static inline int64_t screenrect_words(const PlaneRect& bbx) {
+	const int32_t x0=scrcoord_as_lowerleft(bbx.x0);
+	const int32_t x1=scrcoord_as_lowerleft(bbx.x1);
+	const int32_t y0=scrcoord_as_lowerleft(bbx.y0);
+	const int32_t y1=scrcoord_as_lowerleft(bbx.y1);
+	
+	return (int64_t)(y1-y0+1) * ( (x1 >> 4) - (x0 >> 4) + 1);
+}
+
+// cost model: refining a row costs split^2 bounding boxes per gray
+// pixel now, and saves in each later check of a pixel the scan of the
+// integers its rectangle loses. Decided by a sample of the row
+int8_t Data5::vgridRowPays(const int32_t ay,const NTYP& ascale) {
+	const int32_t split=(1 << _VIRTUALGRIDBITS);
+	PlaneRect A,bbxfA,tight;
+	A.y0=ay*scaleRangePerPixel + COMPLETE0;
+	A.y1=A.y0+scaleRangePerPixel;
+	
+	int64_t savedwords=0;
+	int32_t anzsamples=0;
+	int32_t noch=1;
+	for(int32_t i=0;i<memgrau[ay].anzspans;i++) {
+		for(int32_t x=(memgrau[ay].spans[i].mem0 << 4);x<((memgrau[ay].spans[i].mem1+1) << 4);x++) {
+			int32_t f;
+			GET_SINGLE_CELLCOLOR_XY(x,ay,f);
+			if (f != SQUARE_GRAY) continue;
+			if ((--noch) > 0) continue;
+			noch=VGRIDSAMPLESTEP;
+			
+			A.x0=x*scaleRangePerPixel + COMPLETE0;
+			A.x1=A.x0+scaleRangePerPixel;
+			getBoundingBoxfA(A,bbxfA);
+			anzsamples++;
+			if ((SQUARE_LIES_ENTIRELY_OUTSIDE_GRAY_ENCLOSEMENT(bbxfA))>0) continue;
+			
+			if (calc_shrinkage(A,bbxfA,ascale,tight) >= _SHRINKAGEUSABLE) {
+				savedwords += (screenrect_words(bbxfA) - screenrect_words(tight));
+			}
+		} // x
+	} // i
+	
+	if (anzsamples <= 0) return 0;
+	
+	if (
+		vgridchecks * savedwords >= 
+		(double)anzsamples * split * split * VGRIDWORDSPERBBX
+	) return 1;
+	
+	return 0;
 }
+#endif
 
 // struct HelperAccess
 HelperAccess::HelperAccess() {
@@ -10041,7 +12861,7 @@ void HelperAccess::initMemory(void) {
 	helperblocks=new PHelper[blockanz];
 	if (!helperblocks) {
 		LOGMSG("Memory error. HelperAccess::initMemory\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	
 	for(int32_t i=0;i<blockanz;i++) {
@@ -10094,7 +12914,7 @@ void HelperAccess_double::initMemory(void) {
 	helperblocks=new PHelper_double[blockanz];
 	if (!helperblocks) {
 		LOGMSG("Memory error. HelperAccess_double::initMemory\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	
 	for(int32_t i=0;i<blockanz;i++) {
@@ -10142,7 +12962,7 @@ int32_t fastdtcheck_double(void) {
 		(!getBoundingBoxfA_double_oh)
 	) {
 		LOGMSG("fastdtcheck: function pointer not defined.\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	
 	PlaneRect A,bbxfA;
@@ -10312,15 +13132,7 @@ int32_t fastdtcheck_double(void) {
 			for(int32_t y2=y;y2<(y+REVCGBLOCKWIDTH);y2++) {
 				if (!data5->zeilen[y2]) continue;
 			
-				int32_t xe=x+REVCGBLOCKWIDTH-1;
-				
-				if (
-					(xe < data5->memgrau[y2].g0) ||
-					(x > data5->memgrau[y2].g1)
-				) {
-					// not overlapping
-				} 
-				else {
+				if (data5->memgrau[y2].overlaps(x,x+REVCGBLOCKWIDTH-1) > 0) {
 					hasgray=1;
 					break;
 				}
@@ -10397,7 +13209,7 @@ void StreakArray::pushStreak(const int32_t ax0,const int32_t ax1,const int32_t a
 
 	if (writeidx >= STREAK_MAXBLOCKS) {
 		LOGMSG("Memory-error. pushStreak full\n");
-		exit(99);
+		fatal_exit(99);
 	}
 	if (!ptr[writeidx]) {
 		ptr[writeidx]=new Streak[STREAK_PERBLOCK];
@@ -10414,7 +13226,7 @@ void StreakArray::pushStreak(const int32_t ax0,const int32_t ax1,const int32_t a
 void StreakArray::popStreak(Streak& str) {
 	if (!ptr[writeidx]) {
 		LOGMSG2("Implementation error. StreakArray.pop %i\n",writeidx);
-		exit(99);
+		fatal_exit(99);
 	}
 	if (writenextpos==0) {
 		writeidx--;
@@ -10497,15 +13309,10 @@ int8_t validateInterior(void) {
 			scr.y0=scrcoord_as_lowerleft(bbxfA.y0);
 			scr.y1=scrcoord_as_lowerleft(bbxfA.y1);
 			
-			for(int32_t ty=scr.y0;ty<=scr.y1;ty++) {
-				for(int32_t tx=scr.x0;tx<=scr.x1;tx++) {
-					int32_t flokal;
-					GET_SINGLE_CELLCOLOR_XY(tx,ty,flokal);
-					if (flokal != SQUARE_BLACK) {
-						return 0;
-					}
-				} // tx
-			} // ty
+			const int32_t NOTBLACK=RECTSCAN_GRAY | RECTSCAN_WHITE | RECTSCAN_GRAYPOTW;
+			if (scan_rect_colors(scr,NOTBLACK,0) & NOTBLACK) {
+				return 0;
+			}
 		} // x
 	} // y
 	
@@ -10530,6 +13337,14 @@ void Data5::precomputeScreenRect(void) {
 	for(int32_t i=0;i<SCREENWIDTH;i++) pcscr[i]=NULL;
 	printf("precomputing some screenRects ... ");
 	
+	#ifndef _FPA
+	// subsquare width, a power of 2
+	NTYP vgridscale;
+	vgridscale=scaleRangePerPixel_double / (1 << _VIRTUALGRIDBITS);
+	#endif
+	int32_t vgridrows=0,vgridrowsrefined=0;
+	int64_t vgridpixels=0;
+	
 	for(int32_t threshold=75;threshold>=0;threshold-=25) {
 		printf("%i ",threshold);
 		for(int32_t y=0;y<SCREENWIDTH;y++) {
@@ -10540,12 +13355,15 @@ void Data5::precomputeScreenRect(void) {
 
 			if (pcscr[y]) continue;
 			if (!zeilen[y]) continue; // empty 
-			if (memgrau[y].g1 < memgrau[y].g0) continue;
+			// upper half is never propagated
+			if ( (_SYMMETRY>0) && (y >= (SCREENWIDTH >> 1)) ) continue;
+			if (memgrau[y].anzspans <= 0) continue;
 			
 			// only specific gray density cells
 			if (graudensity[y] < threshold) continue;
 		
-			int64_t touse=((int64_t)memgrau[y].g1-memgrau[y].g0+1);
+			// laid out like the row's memory
+			int64_t touse=((int64_t)memgrau[y].words() << 4);
 			memoryused += (touse*sizeof(ScreenRect));
 			if (memoryused > maxmemory) break;
 			pcscr[y]=pcscrmgr->getMemory(touse);
@@ -10560,44 +13378,68 @@ void Data5::precomputeScreenRect(void) {
 			A.y0=y*scaleRangePerPixel + COMPLETE0;
 			A.y1=A.y0+scaleRangePerPixel;
 			Helper* helperY=helperYdep->getHelper(y);
+			
+			#ifndef _FPA
+			int8_t vgridrow=0;
+			if (_VIRTUALGRIDBITS>0) {
+				vgridrows++;
+				vgridrow=vgridRowPays(y,vgridscale);
+				if (vgridrow>0) vgridrowsrefined++;
+			}
+			#endif
 		
-			for(int32_t x=memgrau[y].g0;x<=memgrau[y].g1;x++) {
-				int32_t f;
-				GET_SINGLE_CELLCOLOR_XY(x,y,f);
-				if (f != SQUARE_GRAY) {
-					SETPCSCR(x,y,-2,-2,-2,-2);
-					continue;
-				}
+			for(int32_t i=0;i<memgrau[y].anzspans;i++) {
+				for(int32_t x=(memgrau[y].spans[i].mem0 << 4);x<((memgrau[y].spans[i].mem1+1) << 4);x++) {
+					int32_t f;
+					GET_SINGLE_CELLCOLOR_XY(x,y,f);
+					if (f != SQUARE_GRAY) {
+						SETPCSCR(x,y,-2,-2,-2,-2);
+						continue;
+					}
 
-				A.x0=x*scaleRangePerPixel + COMPLETE0;
-				A.x1=A.x0+scaleRangePerPixel;
+					A.x0=x*scaleRangePerPixel + COMPLETE0;
+					A.x1=A.x0+scaleRangePerPixel;
 				
-				getBoundingBoxfA_helper(
-					A,bbxfA,
-					helperXdep->getHelper(x),
-					helperY
-				);
+					getBoundingBoxfA_helper(
+						A,bbxfA,
+						helperXdep->getHelper(x),
+						helperY
+					);
+					
+					#ifndef _FPA
+					if (
+						(vgridrow>0) &&
+						((SQUARE_LIES_ENTIRELY_OUTSIDE_GRAY_ENCLOSEMENT(bbxfA)) <= 0)
+					) {
+						PlaneRect tight;
+						if (calc_shrinkage(A,bbxfA,vgridscale,tight) >= _SHRINKAGEUSABLE) {
+							bbxfA=tight;
+							vgridpixels++;
+						}
+					}
+					#endif
 				
-				if ((SQUARE_LIES_ENTIRELY_OUTSIDE_GRAY_ENCLOSEMENT(bbxfA))>0) {
-					SETPCSCR(x,y,-1,-1,0,0);
-				} else {
-					ScreenRect scr;
-					// scr is trimmed to the screen: [0..SCREENWIDT-1]
-					scr.x0=scrcoord_as_lowerleft(bbxfA.x0);
-					scr.x1=scrcoord_as_lowerleft(bbxfA.x1);
-					scr.y0=scrcoord_as_lowerleft(bbxfA.y0);
-					scr.y1=scrcoord_as_lowerleft(bbxfA.y1);
+					if ((SQUARE_LIES_ENTIRELY_OUTSIDE_GRAY_ENCLOSEMENT(bbxfA))>0) {
+						SETPCSCR(x,y,-1,-1,0,0);
+					} else {
+						ScreenRect scr;
+						// scr is trimmed to the screen: [0..SCREENWIDT-1]
+						scr.x0=scrcoord_as_lowerleft(bbxfA.x0);
+						scr.x1=scrcoord_as_lowerleft(bbxfA.x1);
+						scr.y0=scrcoord_as_lowerleft(bbxfA.y0);
+						scr.y1=scrcoord_as_lowerleft(bbxfA.y1);
 					
-					// but does it partially overlap with the outside
-					if (SQUARE_LIES_ENTIRELY_IN_GRAY_ENCLOSEMENT(bbxfA) <= 0) {
-						scr.x0 = -(scr.x0+1); // strictly negative
-					} 
-					SETPCSCR(
-						x,y,
-						scr.x0,scr.x1,scr.y0,scr.y1
-					);
-				} // not totally outside
-			}
+						// but does it partially overlap with the outside
+						if (SQUARE_LIES_ENTIRELY_IN_GRAY_ENCLOSEMENT(bbxfA) <= 0) {
+							scr.x0 = -(scr.x0+1); // strictly negative
+						} 
+						SETPCSCR(
+							x,y,
+							scr.x0,scr.x1,scr.y0,scr.y1
+						);
+					} // not totally outside
+				} // x
+			} // i
 		} // y
 		
 		if (memoryused >= maxmemory) {
@@ -10607,454 +13449,2233 @@ void Data5::precomputeScreenRect(void) {
 
 	printf(" used %I64d GB\n",
 		(memoryused >> 30)+1);
+	if (vgridrows > 0) {
+		LOGMSG4("virtual grid: %i of %i rows refined, %I64d pixels tightened\n",
+			vgridrowsrefined,vgridrows,vgridpixels);
+	}
 }
 
-int32_t main(int32_t argc,char** argv) {
-	int32_t c0=clock();
+// symmetries of the current function and parameters
+// conjugation (real A, c-interval symmetric to the real axis) maps pixel
+// rows exactly onto pixel rows and is exploited with SYMMETRY=1,
+// rotations are only reported
+void detect_symmetry(const int8_t alog) {
+	_SYMMETRY=0;
 	
-	flog=fopen("juliatsacoredyn.log.txt","at");
-	fprintf(flog,"\n-----------------\n");
-	printf("juliatsacoredyn\n");
+	int8_t realA=1;
+	if (FAKTORAim_double != 0.0) realA=0;
+	int8_t conj=0;
+	if (
+		(realA>0) &&
+		(seedC0im_double == -seedC1im_double) 
+	) conj=1;
+	
+	if (alog>0) {
+		if (conj>0) {
+			if (_USESYMMETRY>0) {
+				LOGMSG("symmetry: complex conjugation\n");
+			} else {
+				LOGMSG("symmetry: complex conjugation (not used)\n");
+			}
+		}
+		int32_t deg=0;
+		switch (_FUNC) {
+			case FUNC_Z2C: deg=2; break;
+			case FUNC_2ITZ2C: deg=2; break;
+			case FUNC_Z3AZC: deg=3; break;
+			case FUNC_Z4AZC: deg=4; break;
+			case FUNC_Z5AZC: deg=5; break;
+			case FUNC_Z6AZC: deg=6; break;
+			case FUNC_Z7AZC: deg=7; break;
+			case FUNC_Z8AZC: deg=8; break;
+		}
+		if ( 
+			(deg>0) &&
+			(FAKTORAre_double == 0.0) &&
+			(FAKTORAim_double == 0.0) 
+		) {
+			LOGMSG2("symmetry: %i-fold rotation (not used)\n",deg);
+		} else if ( (deg>0) && ((deg & 1) > 0) ) {
+			// odd degree, c=0: f(-z)=-f(z)
+			if (
+				(seedC0re_double == -seedC1re_double) &&
+				(seedC0im_double == -seedC1im_double)
+			) LOGMSG("symmetry: point reflection (not used)\n");
+		}
+	}
+	
+	if (_USESYMMETRY<=0) return;
+	// tiles must be mirrored onto tiles
+	if (REVCGmaxnumber < 2) return;
+	
+	if (conj>0) _SYMMETRY=1;
+}
 
-	#ifdef _USESPLITGRIDBBX
-	LOGMSG2("_USESPLITGRIDBBX %i\n",_SPLITBBX);
-	#endif
+// number of gray and potentially white pixels
+int64_t count_gray_pixels(void) {
+	int64_t ctr=0;
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		if (!data5->zeilen[y]) continue;
+		const int32_t anzwords=data5->memgrau[y].words();
+		for(int32_t woffset=0;woffset<anzwords;woffset++) {
+			DDBYTE w=data5->zeilen[y][woffset];
+			if (
+				(w == SQUARE_WHITE_16_CONSECUTIVE) ||
+				(w == SQUARE_BLACK_16_CONSECUTIVE)
+			) continue;
+			for(int32_t b=0;b<16;b++) {
+				int32_t f=w & 0b11;
+				if (
+					(f==SQUARE_GRAY) ||
+					(f==SQUARE_GRAY_POTENTIALLY_WHITE)
+				) ctr++;
+				w >>= 2;
+			}
+		}
+	} // y
 	
-	parentmgr=new ParentManager;
-	int32_t cmd=CMD_CALC;
+	return ctr;
+}
+
+// struct CacheLevel
+CacheLevel::CacheLevel(const int32_t abytes,const int32_t aways) {
+	ways=aways;
+	anzsets=(abytes >> 6) / ways;
+	tags=new uint64_t[(int64_t)anzsets*ways];
+	// no line address is all ones
+	for(int64_t i=0;i<((int64_t)anzsets*ways);i++) tags[i]=~(uint64_t)0;
+	accesses=misses=0;
+}
+
+CacheLevel::~CacheLevel() {
+	delete[] tags;
+}
+
+// 1 if line aline was present
+int8_t CacheLevel::access(const uint64_t aline) {
+	accesses++;
+	uint64_t* set=&tags[(int64_t)(aline % anzsets)*ways];
+	int32_t w=0;
+	while ( (w < (ways-1)) && (set[w] != aline) ) w++;
+	const int8_t hit=(set[w] == aline);
+	if (!hit) misses++;
+	// move to front, the least recently used one drops out
+	for(int32_t i=w;i>0;i--) set[i]=set[i-1];
+	set[0]=aline;
+	
+	return hit;
+}
+
+// struct CacheModel
+CacheModel::CacheModel() {
+	l1=new CacheLevel(32 << 10,8);
+	l2=new CacheLevel(1 << 20,16);
+	lastline=~(uint64_t)0;
+}
+
+CacheModel::~CacheModel() {
+	delete l1;
+	delete l2;
+}
+
+void CacheModel::touch(const void* p) {
+	const uint64_t line=(uint64_t)(uintptr_t)p >> 6;
+	// consecutive reads of the same line count once
+	if (line == lastline) return;
+	lastline=line;
+	if (l1->access(line) <= 0) l2->access(line);
+}
+
+// interleaves the bits of ax (even positions) and ay (odd)
+static inline uint64_t morton_key(const uint32_t ax,const uint32_t ay) {
+	uint64_t k=0;
+	for(int32_t b=0;b<32;b++) {
+		k |= (uint64_t)((ax >> b) & 1) << (b << 1);
+		k |= (uint64_t)((ay >> b) & 1) << ((b << 1)+1);
+	}
+	
+	return k;
+}
+
+struct BrickEntry {
+	uint64_t key;
+	int8_t black;
+};
+
+static int compare_brickentry(const void* a,const void* b) {
+	const BrickEntry* pa=(const BrickEntry*)a;
+	const BrickEntry* pb=(const BrickEntry*)b;
+	if (pa->key != pb->key) return (pa->key < pb->key) ? -1 : 1;
+	
+	return 0;
+}
+
+// struct BrickImage
+BrickImage::BrickImage() {
+	anzbricks=anzwords=0;
+	keys=NULL;
+	offset=NULL;
+	words=NULL;
+}
+
+BrickImage::~BrickImage() {
+	if (keys) delete[] keys;
+	if (offset) delete[] offset;
+	if (words) delete[] words;
+}
+
+// copies the current image of data5
+void BrickImage::build(void) {
+	const int32_t BRICKROWWORDS=(1 << BRICKBITS) >> 4;
+	const int32_t BRICKMASK=(1 << BRICKBITS)-1;
+	const int32_t bw=(SCREENWIDTH+BRICKMASK) >> BRICKBITS;
+	int8_t* nonwhite=new int8_t[bw];
+	int32_t* blackctr=new int32_t[bw];
+	int64_t allok=1024;
+	BrickEntry* entries=new BrickEntry[allok];
+	anzbricks=0;
+	
+	// which bricks are not completely white and which are completely black
+	for(int32_t by=0;by<bw;by++) {
+		for(int32_t bx=0;bx<bw;bx++) {
+			nonwhite[bx]=0;
+			blackctr[bx]=0;
+		}
+		const int32_t y1=minimumI(SCREENWIDTH-1,(by << BRICKBITS)+BRICKMASK);
+		for(int32_t y=(by << BRICKBITS);y<=y1;y++) {
+			int32_t start;
+			const int32_t laenge=data5->getRowWords(y,data5->rowbuffer,start);
+			for(int32_t i=0;i<laenge;i++) {
+				const DDBYTE w=data5->rowbuffer[i];
+				if (w == SQUARE_WHITE_16_CONSECUTIVE) continue;
+				const int32_t bx=(start+i) / BRICKROWWORDS;
+				nonwhite[bx]=1;
+				if (w == SQUARE_BLACK_16_CONSECUTIVE) blackctr[bx]++;
+			}
+		}
+		for(int32_t bx=0;bx<bw;bx++) {
+			if (nonwhite[bx] <= 0) continue;
+			if (anzbricks >= allok) {
+				BrickEntry* tmp=new BrickEntry[2*allok];
+				memcpy(tmp,entries,allok*sizeof(BrickEntry));
+				delete[] entries;
+				entries=tmp;
+				allok *= 2;
+			}
+			entries[anzbricks].key=morton_key(bx,by);
+			entries[anzbricks].black=(blackctr[bx] == BRICKWORDS);
+			anzbricks++;
+		}
+	} // by
+	
+	delete[] nonwhite;
+	delete[] blackctr;
+	
+	qsort(entries,anzbricks,sizeof(BrickEntry),compare_brickentry);
+	keys=new uint64_t[anzbricks+1];
+	offset=new int64_t[anzbricks+1];
+	anzwords=0;
+	for(int64_t i=0;i<anzbricks;i++) {
+		keys[i]=entries[i].key;
+		if (entries[i].black > 0) offset[i]=-1;
+		else {
+			offset[i]=anzwords;
+			anzwords += BRICKWORDS;
+		}
+	}
+	delete[] entries;
+	
+	words=new DDBYTE[anzwords+1];
+	if ( (!keys) || (!offset) || (!words) ) {
+		LOGMSG("Memory error. BrickImage\n");
+		fatal_exit(99);
+	}
+	for(int64_t i=0;i<anzwords;i++) words[i]=SQUARE_WHITE_16_CONSECUTIVE;
+	
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		int32_t start;
+		const int32_t laenge=data5->getRowWords(y,data5->rowbuffer,start);
+		int32_t lastbx=-1;
+		int64_t idx=-1;
+		for(int32_t i=0;i<laenge;i++) {
+			const int32_t bx=(start+i) / BRICKROWWORDS;
+			if (bx != lastbx) {
+				idx=find(bx,y >> BRICKBITS,NULL);
+				lastbx=bx;
+			}
+			if ( (idx < 0) || (offset[idx] < 0) ) continue;
+			words[offset[idx] + (y & BRICKMASK)*BRICKROWWORDS + ((start+i) % BRICKROWWORDS)]=data5->rowbuffer[i];
+		}
+	} // y
+}
+
+// index of brick (abx,aby), -1 if it is white. If acm is given, the
+// lines read by the search are passed to it
+int64_t BrickImage::find(const int32_t abx,const int32_t aby,CacheModel* acm) {
+	if (anzbricks <= 0) return -1;
+	
+	const uint64_t key=morton_key(abx,aby);
+	int64_t left=0,right=anzbricks-1;
+	while (left < right) {
+		int64_t m=(left+right) >> 1;
+		if (acm) acm->touch(&keys[m]);
+		if (keys[m] < key) left=m+1; else right=m;
+	}
+	if (acm) acm->touch(&keys[left]);
+	
+	if (keys[left] != key) return -1;
+	
+	return left;
+}
+
+int32_t BrickImage::colorAt(const int32_t ax,const int32_t ay) {
+	const int64_t idx=find(ax >> BRICKBITS,ay >> BRICKBITS,NULL);
+	if (idx < 0) return SQUARE_WHITE;
+	if (offset[idx] < 0) return SQUARE_BLACK;
+	
+	const int32_t BRICKROWWORDS=(1 << BRICKBITS) >> 4;
+	const DDBYTE w=words[
+		offset[idx] + 
+		(ay & ((1 << BRICKBITS)-1))*BRICKROWWORDS + 
+		((ax >> 4) % BRICKROWWORDS)
+	];
+	
+	return (w >> ((ax & 0b1111) << 1)) & 0b11;
+}
+
+// as scan_rect_colors_rows, brick by brick and stopping after a brick
+int32_t BrickImage::scanRect(
+	const ScreenRect& scr,
+	const int32_t astopany,const int32_t astopall
+) {
+	const int32_t BRICKROWWORDS=(1 << BRICKBITS) >> 4;
+	const int32_t BRICKMASK=(1 << BRICKBITS)-1;
+	int32_t found=0;
+	const int32_t m0=scr.x0 >> 4;
+	const int32_t m1=scr.x1 >> 4;
+	const uint32_t firstmask=lanemask(scr.x0 & 0b1111,15);
+	const uint32_t lastmask=lanemask(0,scr.x1 & 0b1111);
+	
+	for(int32_t by=(scr.y0 >> BRICKBITS);by<=(scr.y1 >> BRICKBITS);by++) {
+		const int32_t ry0=maximumI(scr.y0,by << BRICKBITS);
+		const int32_t ry1=minimumI(scr.y1,(by << BRICKBITS)+BRICKMASK);
+		for(int32_t bx=(scr.x0 >> BRICKBITS);bx<=(scr.x1 >> BRICKBITS);bx++) {
+			const int64_t idx=find(bx,by,NULL);
+			if (idx < 0) found |= RECTSCAN_WHITE;
+			else if (offset[idx] < 0) found |= RECTSCAN_BLACK;
+			else {
+				const int32_t a=maximumI(m0,bx*BRICKROWWORDS);
+				const int32_t b=minimumI(m1,(bx+1)*BRICKROWWORDS-1);
+				for(int32_t ry=ry0;ry<=ry1;ry++) {
+					const DDBYTE* row=&words[offset[idx] + (ry & BRICKMASK)*BRICKROWWORDS];
+					for(int32_t m=a;m<=b;m++) {
+						uint32_t mask=LANES_LOWBIT;
+						if (m == m0) mask &= firstmask;
+						if (m == m1) mask &= lastmask;
+						found |= classify_word(row[m % BRICKROWWORDS],mask);
+					}
+				}
+			}
+			
+			if (
+				( (found & astopany) != 0 ) ||
+				( (astopall != 0) && ( (found & astopall) == astopall) )
+			) return found;
+		} // bx
+	} // by
+	
+	return found;
+}
+
+// passes the lines a complete scanRect reads to acm
+void BrickImage::touchRect(const ScreenRect& scr,CacheModel& acm) {
+	const int32_t BRICKROWWORDS=(1 << BRICKBITS) >> 4;
+	const int32_t BRICKMASK=(1 << BRICKBITS)-1;
+	const int32_t m0=scr.x0 >> 4;
+	const int32_t m1=scr.x1 >> 4;
+	
+	for(int32_t by=(scr.y0 >> BRICKBITS);by<=(scr.y1 >> BRICKBITS);by++) {
+		const int32_t ry0=maximumI(scr.y0,by << BRICKBITS);
+		const int32_t ry1=minimumI(scr.y1,(by << BRICKBITS)+BRICKMASK);
+		for(int32_t bx=(scr.x0 >> BRICKBITS);bx<=(scr.x1 >> BRICKBITS);bx++) {
+			const int64_t idx=find(bx,by,&acm);
+			if (idx < 0) continue;
+			acm.touch(&offset[idx]);
+			if (offset[idx] < 0) continue;
+			const int32_t a=maximumI(m0,bx*BRICKROWWORDS);
+			const int32_t b=minimumI(m1,(bx+1)*BRICKROWWORDS-1);
+			for(int32_t ry=ry0;ry<=ry1;ry++) {
+				const DDBYTE* row=&words[offset[idx] + (ry & BRICKMASK)*BRICKROWWORDS];
+				for(int32_t m=a;m<=b;m++) acm.touch(&row[m % BRICKROWWORDS]);
+			}
+		} // bx
+	} // by
+}
+
+int64_t BrickImage::memory(void) {
+	return anzbricks*(sizeof(uint64_t)+sizeof(int64_t)) + anzwords*sizeof(DDBYTE);
+}
+
+// passes the lines a complete scan_rect_colors_rows reads to acm
+static void touch_rect_rows(const ScreenRect& scr,CacheModel& acm) {
+	const int32_t m0=scr.x0 >> 4;
+	const int32_t m1=scr.x1 >> 4;
+	
+	for(int32_t ty=scr.y0;ty<=scr.y1;ty++) {
+		const Gray_in_row* mg=&data5->memgrau[ty];
+		acm.touch(mg);
+		if (mg->anzspans <= 0) continue;
+		acm.touch(&data5->zeilen[ty]);
+		
+		// the search of firstSpan
+		int32_t left=0,right=mg->anzspans-1;
+		while (left < right) {
+			int32_t m=(left+right) >> 1;
+			acm.touch(&mg->spans[m]);
+			if (mg->spans[m].mem1 < m0) left=m+1; else right=m;
+		}
+		
+		for(int32_t sp=left;sp<mg->anzspans;sp++) {
+			acm.touch(&mg->spans[sp]);
+			if (mg->spans[sp].mem1 < m0) continue;
+			if (mg->spans[sp].mem0 > m1) break;
+			const int32_t a=maximumI(m0,mg->spans[sp].mem0);
+			const int32_t b=minimumI(m1,mg->spans[sp].mem1);
+			const DDBYTE* row=&data5->zeilen[ty][mg->spans[sp].offset+a-mg->spans[sp].mem0];
+			for(int32_t i=0;i<=(b-a);i++) acm.touch(&row[i]);
+		}
+	} // ty
+}
+
+static inline int8_t rectscan_stopped(const int32_t af,const int32_t astopany,const int32_t astopall) {
+	if ( (af & astopany) != 0 ) return 1;
+	if ( (astopall != 0) && ( (af & astopall) == astopall) ) return 1;
+	
+	return 0;
+}
+
+// cmd=layoutbench: the bounding boxes of the gray pixels of the final
+// image are scanned in the row layout of data5 and in 64x64 pixel
+// bricks. Reports time, memory and the L1/L2 misses of a cache model
+void layout_benchmark(void) {
+	const int64_t MAXRECTS=(1 << 20);
+	const int64_t gray=count_gray_pixels();
+	const int64_t stride=(gray / MAXRECTS)+1;
+	ScreenRect* rects=new ScreenRect[MAXRECTS];
+	int64_t anzrects=0;
+	
+	LOGMSG("\nlayout benchmark ...\n");
+	BrickImage bricks;
+	bricks.build();
+	
+	// every stride-th gray pixel's bounding box
+	PlaneRect A,bbxfA;
+	int64_t ctr=0,colorerr=0;
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		int32_t start;
+		const int32_t laenge=data5->getRowWords(y,data5->rowbuffer,start);
+		if (laenge <= 0) continue;
+		
+		A.y0=y*scaleRangePerPixel + COMPLETE0;
+		A.y1=A.y0+scaleRangePerPixel;
+		Helper* helperY=helperYdep->getHelper(y);
+		
+		for(int32_t i=0;i<laenge;i++) {
+			DDBYTE w=data5->rowbuffer[i];
+			if (
+				(w == SQUARE_WHITE_16_CONSECUTIVE) ||
+				(w == SQUARE_BLACK_16_CONSECUTIVE)
+			) continue;
+			for(int32_t b=0;b<16;b++) {
+				const int32_t f=w & 0b11;
+				w >>= 2;
+				if (
+					(f != SQUARE_GRAY) &&
+					(f != SQUARE_GRAY_POTENTIALLY_WHITE)
+				) continue;
+				if ( ((ctr++) % stride) != 0) continue;
+				
+				const int32_t x=((start+i) << 4) + b;
+				if (bricks.colorAt(x,y) != f) colorerr++;
+				A.x0=x*scaleRangePerPixel + COMPLETE0;
+				A.x1=A.x0+scaleRangePerPixel;
+				getBoundingBoxfA_helper(
+					A,bbxfA,
+					helperXdep->getHelper(x),
+					helperY);
+				if (SQUARE_LIES_ENTIRELY_IN_GRAY_ENCLOSEMENT(bbxfA) <= 0) continue;
+				if (anzrects >= MAXRECTS) continue;
+				
+				rects[anzrects].x0=scrcoord_as_lowerleft(bbxfA.x0);
+				rects[anzrects].x1=scrcoord_as_lowerleft(bbxfA.x1);
+				rects[anzrects].y0=scrcoord_as_lowerleft(bbxfA.y0);
+				rects[anzrects].y1=scrcoord_as_lowerleft(bbxfA.y1);
+				anzrects++;
+			} // b
+		} // i
+	} // y
+	
+	if (anzrects <= 0) {
+		LOGMSG("  no gray pixels, nothing to measure\n");
+		delete[] rects;
+		return;
+	}
+	
+	double avgw=0,avgh=0;
+	for(int64_t r=0;r<anzrects;r++) {
+		avgw += (rects[r].x1-rects[r].x0+1);
+		avgh += (rects[r].y1-rects[r].y0+1);
+	}
+	LOGMSG5("  %I64d bounding boxes (every %I64d-th gray pixel) of %.1lf x %.1lf pixels on average\n",
+		anzrects,stride,avgw/anzrects,avgh/anzrects);
+	
+	int64_t rowsmem=(int64_t)SCREENWIDTH*(sizeof(Gray_in_row)+sizeof(DDBYTE*));
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		rowsmem += data5->memgrau[y].words()*sizeof(DDBYTE) + data5->memgrau[y].anzspans*sizeof(GraySpan);
+	}
+	
+	// the stop conditions of propagate_definite, the potw search
+	// and a complete scan
+	const int32_t STOPANY[3]={ RECTSCAN_GRAY | RECTSCAN_GRAYPOTW,RECTSCAN_WHITE | RECTSCAN_GRAYPOTW,0 };
+	const int32_t STOPALL[3]={ RECTSCAN_WHITE | RECTSCAN_BLACK,0,0 };
+	double secrows[3],secbricks[3];
+	int32_t* flags=new int32_t[anzrects];
+	int64_t mismatch=0;
+	for(int32_t mode=0;mode<3;mode++) {
+		clock_t t0=clock();
+		for(int64_t r=0;r<anzrects;r++) {
+			flags[r]=scan_rect_colors_rows(rects[r],STOPANY[mode],STOPALL[mode]);
+		}
+		secrows[mode]=(double)(clock()-t0)/CLOCKS_PER_SEC;
+		
+		t0=clock();
+		for(int64_t r=0;r<anzrects;r++) {
+			// both have to stop, or find the same colors if not
+			const int32_t f=bricks.scanRect(rects[r],STOPANY[mode],STOPALL[mode]);
+			const int8_t sr=rectscan_stopped(flags[r],STOPANY[mode],STOPALL[mode]);
+			if (sr != rectscan_stopped(f,STOPANY[mode],STOPALL[mode])) mismatch++;
+			else if ( (sr <= 0) && (f != flags[r]) ) mismatch++;
+		}
+		secbricks[mode]=(double)(clock()-t0)/CLOCKS_PER_SEC;
+	}
+	delete[] flags;
+	
+	CacheModel cmrows,cmbricks;
+	for(int64_t r=0;r<anzrects;r++) {
+		touch_rect_rows(rects[r],cmrows);
+		bricks.touchRect(rects[r],cmbricks);
+	}
+	delete[] rects;
+	
+	LOGMSG("  seconds for stop at definite / potw / full scan, memory\n");
+	LOGMSG5("  rows  : %.3lf / %.3lf / %.3lf s, %I64d KB\n",secrows[0],secrows[1],secrows[2],rowsmem >> 10);
+	LOGMSG5("  bricks: %.3lf / %.3lf / %.3lf s, %I64d KB\n",secbricks[0],secbricks[1],secbricks[2],bricks.memory() >> 10);
+	LOGMSG("  full scans in a cache model (L1 32 KB 8-way, L2 1 MB 16-way, 64 byte lines):\n");
+	#define LAYOUTLINE(NAME,CM) \
+		LOGMSG5("  %s: %.1lf lines per box, L1 misses %.2lf%%, L2 misses %.2lf%% of L1 misses\n",\
+			NAME,\
+			(double)CM.l1->accesses/anzrects,\
+			100.0*CM.l1->misses/( (CM.l1->accesses > 0) ? CM.l1->accesses : 1),\
+			100.0*CM.l2->misses/( (CM.l2->accesses > 0) ? CM.l2->accesses : 1));
+	LAYOUTLINE("rows  ",cmrows)
+	LAYOUTLINE("bricks",cmbricks)
+	#undef LAYOUTLINE
+	
+	if ( (mismatch > 0) || (colorerr > 0) ) {
+		LOGMSG3("Implementation error. Layouts differ in %I64d bounding boxes, %I64d pixels\n",mismatch,colorerr);
+	}
+}
+
+// pixels hit by the bounding box abbx. Pixels are closed: a right or
+// upper edge on a pixel border does not add the pixel beyond, so a row
+// mirrored by symmetry is checked as tightly as its twin
+static void verify_screenrect(const PlaneRect& abbx,ScreenRect& scr) {
+	NTYP e;
+	scr.x0=scrcoord_as_lowerleft(abbx.x0);
+	scr.x1=scrcoord_as_lowerleft(abbx.x1);
+	scr.y0=scrcoord_as_lowerleft(abbx.y0);
+	scr.y1=scrcoord_as_lowerleft(abbx.y1);
+	if (scr.x1 > scr.x0) {
+		set_plane_coord(e,scr.x1);
+		if (!(e < abbx.x1)) scr.x1--;
+	}
+	if (scr.y1 > scr.y0) {
+		set_plane_coord(e,scr.y1);
+		if (!(e < abbx.y1)) scr.y1--;
+	}
+}
+
+// verify: does the black pixel (ax,ay) keep its color under one bounding
+// box step. The black pixels then form a set inside the gray enclosure
+// that is mapped into itself, so no orbit starting there escapes
+static int8_t verify_black_pixel(const int32_t ax,const int32_t ay) {
+	PlaneRect A,bbxfA;
+	set_plane_coord(A.x0,ax);
+	set_plane_coord(A.x1,ax+1);
+	set_plane_coord(A.y0,ay);
+	set_plane_coord(A.y1,ay+1);
+	getBoundingBoxfA(A,bbxfA);
+	
+	if (SQUARE_LIES_ENTIRELY_IN_GRAY_ENCLOSEMENT(bbxfA) <= 0) return 0;
+	
+	ScreenRect scr;
+	verify_screenrect(bbxfA,scr);
+	
+	const int32_t other=RECTSCAN_GRAY | RECTSCAN_GRAYPOTW | RECTSCAN_WHITE;
+	if ( (scan_rect_colors(scr,other,0) & other) == 0) return 1;
+	
+	return 0;
+}
+
+// does scr contain a pixel whose white claim is not proven yet.
+// apending holds one bit per pixel, 16 per image integer
+static int8_t verify_rect_pending(const uint16_t* apending,const ScreenRect& scr) {
+	const int32_t words=SCREENWIDTH >> 4;
+	const int32_t m0=scr.x0 >> 4;
+	const int32_t m1=scr.x1 >> 4;
+	const uint32_t firstmask=(0xFFFF << (scr.x0 & 0b1111)) & 0xFFFF;
+	const uint32_t lastmask=0xFFFF >> (15-(scr.x1 & 0b1111));
+	
+	for(int32_t ty=scr.y0;ty<=scr.y1;ty++) {
+		const uint16_t* row=&apending[(int64_t)ty*words];
+		for(int32_t m=m0;m<=m1;m++) {
+			uint32_t bits=row[m];
+			if (m == m0) bits &= firstmask;
+			if (m == m1) bits &= lastmask;
+			if (bits != 0) return 1;
+		}
+	}
+	
+	return 0;
+}
+
+// is the claimed white rectangle A (a pixel or a 16x16 block) proven:
+// its box leaves the range square or the escape disk, or it hits only
+// white pixels that are proven already. Parts of the box outside the
+// screen lie outside the range and escape. If not, scr holds the
+// pixels the box hits
+static int8_t verify_white_rect(const uint16_t* apending,PlaneRect& A,ScreenRect& scr) {
+	PlaneRect bbxfA;
+	getBoundingBoxfA(A,bbxfA);
+	if (SQUARE_LIES_ENTIRELY_IN_SPECEXT(bbxfA) > 0) return 1;
+	
+	verify_screenrect(bbxfA,scr);
+	
+	const int32_t other=RECTSCAN_GRAY | RECTSCAN_GRAYPOTW | RECTSCAN_BLACK;
+	if ( (scan_rect_colors(scr,other,0) & other) != 0) return 0;
+	
+	return (verify_rect_pending(apending,scr) > 0) ? 0 : 1;
+}
+
+// per 16x16 block of the white proof: the sweep of the last check, the
+// last sweep a pixel was proven in, and the blocks hit by the pixels
+// that failed, so a block is only checked again once one of those
+// blocks has changed
+struct VerifyBlock {
+	int32_t checkedin,provenin;
+	uint16_t bx0,bx1,by0,by1;
+};
+
+// cmd=verify, white part: the claimed white pixels are proven backwards
+// from the escape region. A pixel is proven if verify_white_rect holds
+// with the pixels proven so far, the image is swept alternately
+// downwards and upwards until nothing changes. Whatever remains is
+// claimed white without reaching the escape region and fails.
+// Whole 16x16 blocks of unproven white are tried as one box first.
+// Needs 1.5 bits per pixel. Returns 1 if all claimed white pixels escape
+static int8_t verify_white(int64_t& actrblocks,int64_t& actrpixels,int32_t& asweeps) {
+	const int32_t words=SCREENWIDTH >> 4;
+	uint16_t* pending=new uint16_t[(int64_t)words*SCREENWIDTH];
+	VerifyBlock* blocks=new VerifyBlock[(int64_t)words*words];
+	int64_t anzpending=0;
+	
+	for(int32_t y=0;y<SCREENWIDTH;y++) {
+		uint16_t* row=&pending[(int64_t)y*words];
+		for(int32_t mem=0;mem<words;mem++) {
+			DDBYTE w;
+			GETDATA5BYMEM_MY(mem,y,w);
+			const uint32_t lanes=lanes_of_color(w,SQUARE_WHITE);
+			uint32_t bits=0;
+			for(int32_t b=0;b<16;b++) {
+				if ( (lanes >> (b << 1)) & 1) {
+					bits |= (1 << b);
+					anzpending++;
+				}
+			}
+			row[mem]=(uint16_t)bits;
+		}
+	}
+	for(int64_t i=0;i<((int64_t)words*words);i++) {
+		blocks[i].checkedin=-1;
+		blocks[i].provenin=-1;
+	}
+	LOGMSG3("\n  %I64d claimed white pixels, %.1lf MB for the proof\n",
+		anzpending,(double)words*(SCREENWIDTH*sizeof(uint16_t)+words*sizeof(VerifyBlock))/1048576.0);
+	
+	asweeps=0;
+	int64_t changed=1;
+	while ( (changed > 0) && (anzpending > 0) ) {
+		changed=0;
+		const int32_t up=(asweeps & 1);
+		for(int32_t i16=0;i16<SCREENWIDTH;i16+=16) {
+			const int32_t y16=(up > 0) ? (SCREENWIDTH-16-i16) : i16;
+			for(int32_t x16=0;x16<SCREENWIDTH;x16+=16) {
+				const int32_t mem=x16 >> 4;
+				uint32_t any=0,all=0xFFFF;
+				for(int32_t y=y16;y<(y16+16);y++) {
+					const uint32_t bits=pending[(int64_t)y*words+mem];
+					any |= bits;
+					all &= bits;
+				}
+				if (any == 0) continue;
+				
+				VerifyBlock* bl=&blocks[(int64_t)(y16 >> 4)*words+mem];
+				if (bl->checkedin >= 0) {
+					// anything proven where the failed pixels hit
+					int8_t dirty=0;
+					for(int32_t by=bl->by0;(by<=bl->by1) && (dirty <= 0);by++) {
+						const VerifyBlock* row=&blocks[(int64_t)by*words];
+						for(int32_t bx=bl->bx0;bx<=bl->bx1;bx++) {
+							if (row[bx].provenin >= bl->checkedin) {
+								dirty=1;
+								break;
+							}
+						}
+					}
+					if (dirty <= 0) continue;
+				}
+				
+				ScreenRect scr;
+				if (all == 0xFFFF) {
+					// blocks do not straddle an axis
+					PlaneRect A16;
+					set_plane_coord(A16.x0,x16);
+					set_plane_coord(A16.x1,x16+16);
+					set_plane_coord(A16.y0,y16);
+					set_plane_coord(A16.y1,y16+16);
+					actrblocks++;
+					if (verify_white_rect(pending,A16,scr) > 0) {
+						for(int32_t y=y16;y<(y16+16);y++) {
+							pending[(int64_t)y*words+mem]=0;
+						}
+						anzpending -= 256;
+						changed += 256;
+						bl->provenin=asweeps;
+						continue;
+					}
+				}
+				
+				// pixel by pixel
+				ScreenRect hit;
+				hit.x0=hit.y0=words;
+				hit.x1=hit.y1=-1;
+				for(int32_t y=y16;y<(y16+16);y++) {
+					uint16_t* p=&pending[(int64_t)y*words+mem];
+					if (*p == 0) continue;
+					for(int32_t b=0;b<16;b++) {
+						if ( ( (*p >> b) & 1) == 0) continue;
+						PlaneRect A;
+						set_plane_coord(A.x0,x16+b);
+						set_plane_coord(A.x1,x16+b+1);
+						set_plane_coord(A.y0,y);
+						set_plane_coord(A.y1,y+1);
+						actrpixels++;
+						if (verify_white_rect(pending,A,scr) > 0) {
+							*p &= (uint16_t)~(1 << b);
+							anzpending--;
+							changed++;
+							bl->provenin=asweeps;
+						} else {
+							if ( (scr.x0 >> 4) < hit.x0) hit.x0=scr.x0 >> 4;
+							if ( (scr.x1 >> 4) > hit.x1) hit.x1=scr.x1 >> 4;
+							if ( (scr.y0 >> 4) < hit.y0) hit.y0=scr.y0 >> 4;
+							if ( (scr.y1 >> 4) > hit.y1) hit.y1=scr.y1 >> 4;
+						}
+					}
+				}
+				
+				bl->checkedin=asweeps;
+				bl->bx0=(uint16_t)hit.x0;
+				bl->bx1=(uint16_t)hit.x1;
+				bl->by0=(uint16_t)hit.y0;
+				bl->by1=(uint16_t)hit.y1;
+			} // x16
+		} // i16
+		asweeps++;
+		printf("%I64d ",anzpending);
+	} // while
+	
+	if (anzpending > 0) {
+		// the first pixel left over as counterexample
+		int64_t idx=0;
+		while (pending[idx] == 0) idx++;
+		int32_t b=0;
+		while ( ( (pending[idx] >> b) & 1) == 0) b++;
+		LOGMSG4("\n  counterexample: %I64d white pixels do not reach the escape region, e.g. (%i,%i)\n",
+			anzpending,(int32_t)(idx % words)*16+b,(int32_t)(idx / words));
+	}
+	const int8_t passed=(anzpending > 0) ? 0 : 1;
+	
+	delete[] blocks;
+	delete[] pending;
+	
+	return passed;
+}
+
+// cmd=verify: the white and black claims of the loaded image are checked
+// again with the bounding box function that does not use the helpers.
+// White is proven by verify_white over the whole image, done by slice 0
+// only. Black is checked pixel by pixel in the block rows _VERIFYSLICE,
+// _VERIFYSLICE+_VERIFYSLICES, ... and stops at the first counterexample.
+// Returns 1 if all pixels passed
+int8_t verify_image(void) {
+	const int64_t bbx0=ctrbbxfa;
+	const clock_t c0=clock();
+	int64_t ctrpixels=0,ctrblocks=0;
+	int32_t sweeps=0;
+	
+	if (_VERIFYSLICE == 0) {
+		if (verify_white(ctrblocks,ctrpixels,sweeps) <= 0) return 0;
+	}
+	
+	int32_t noch0=(SCREENWIDTH >> 4) >> 3;
+	int32_t noch=1;
+	for(int32_t y16=(_VERIFYSLICE << 4);y16<SCREENWIDTH;y16+=(_VERIFYSLICES << 4)) {
+		if ((noch -= _VERIFYSLICES)<=0) {
+			printf("%i ",SCREENWIDTH-y16);
+			noch=noch0;
+		}
+		for(int32_t y=y16;y<(y16+16);y++) {
+			for(int32_t mem=0;mem<(SCREENWIDTH >> 4);mem++) {
+				DDBYTE w;
+				GETDATA5BYMEM_MY(mem,y,w);
+				const uint32_t lanes=lanes_of_color(w,SQUARE_BLACK);
+				if (lanes == 0) continue;
+				
+				for(int32_t b=0;b<16;b++) {
+					if ( ( (lanes >> (b << 1)) & 1) == 0) continue;
+					
+					const int32_t x=(mem << 4)+b;
+					ctrpixels++;
+					if (verify_black_pixel(x,y) <= 0) {
+						LOGMSG3("\n  counterexample: black pixel (%i,%i) does not keep its color\n",x,y);
+						return 0;
+					}
+				}
+			}
+		}
+	} // y16
+	
+	double sec=(double)(clock()-c0)/CLOCKS_PER_SEC;
+	if (sec < 0.001) sec=0.001;
+	LOGMSG6("\n  %I64d white 16x16 blocks and %I64d pixels checked in %i sweeps with %I64d bounding boxes in %.1lf sec\n",
+		ctrblocks,ctrpixels,sweeps,ctrbbxfa-bbx0,sec);
+	LOGMSG2("  %.2lf million bounding boxes per second\n",(ctrbbxfa-bbx0)/sec*1E-6);
+	
+	return 1;
+}
+
+// everything that only depends on the resolution
+void set_refinement_level(const int32_t alevel,const int32_t arevcgbits) {
+	SCREENWIDTH=(1 << alevel);
+	REFINEMENTLEVEL=alevel;
+	REVCGBITS=arevcgbits;
+	
+	// SCREENWIDTH / (2^REVCGBITS) <= 2^15
+	// REVCG allocated en bloc => adjust REVCGBITS
+	// revcg-Parents numbered with 16 bit
+	while ( (SCREENWIDTH >> REVCGBITS) > (1 << 15)) REVCGBITS++;
+	// window mode: tiles grow with the level instead, so the reverse
+	// cell graph's tables do not grow with the square of the width
+	if (_WINDOW>0) {
+		while ( (SCREENWIDTH >> REVCGBITS) > WINDOWMAXTILES) REVCGBITS++;
+	}
+
+	REVCGBLOCKWIDTH=(1 << REVCGBITS);
+	if (SCREENWIDTH >= REVCGBLOCKWIDTH) {
+		REVCGmaxnumber=SCREENWIDTH >> REVCGBITS;
+	} else REVCGmaxnumber=1;
+	REVCGmaxnumberQ=REVCGmaxnumber*REVCGmaxnumber;
+
+	double w=(RANGE1-RANGE0) / (double)SCREENWIDTH;
+	scaleRangePerPixel=w;
+	scaleRangePerPixel_double=w;
+
+	w=(double)SCREENWIDTH / (RANGE1-RANGE0);
+	scalePixelPerRange=w;
+	scalePixelPerRange_double=w;
+	// w is a power of 2
+	scalePixelPerRangeExponent=getPower2Exponent( (uint64_t)w );
+}
+
+// parameter values if not given on the command line
+void set_default_parameters(void) {
 	getBoundingBoxfA=getBoundingBoxfA_z2c;
 	_FUNC=FUNC_Z2C;
 	RANGE0=-2.0;
 	RANGE1=2.0;
 	seedC0re=seedC1re=-1.0;
 	seedC0im=seedC1im=0.0;
+	seedC0re_double=seedC1re_double=-1.0;
+	seedC0im_double=seedC1im_double=0.0;
 	FAKTORAre=FAKTORAim=0.0;
+	FAKTORAre_double=FAKTORAim_double=0.0;
 	REVCGBITS=4;
 	SCREENWIDTH=(1 << 10);
 	_RESETPOTW=0;
-	
-	for(int32_t i=1;i<argc;i++) {
-		upper(argv[i]);
-		if (strstr(argv[i],"FUNC=")==argv[i]) {
-			_FUNC=getfuncidx(&argv[i][5]);
+	_PERIODICPOINTS=0;
+	_PERIODICITYMETHOD=1;
+	_PROPAGATEDEF=1;
+	_PROPAGATEPOTW=1;
+	_PRECOMPUTEBBXMEMORYGB=0;
+	_POTWBFSMEMORYGB=1;
+	_ORDER=ORDER_RASTER;
+	_BBXMETHOD=BBX_IA;
+	_VIRTUALGRIDBITS=0;
+	_SHRINKAGEUSABLE=1;
+	_BLACKGAPS=1;
+	_WINDOW=0;
+	_ORACLELEVEL=0;
+	_VERIFYSLICE=0;
+	_VERIFYSLICES=1;
+	_ESCAPEDISK=1;
+	LEVELFROM=LEVELTO=0;
+	_LEVELCHECKPOINT=0;
+	_USESYMMETRY=0;
+}
+
+// one KEY=value command line parameter, arg is already upper case
+void parse_parameter(char* arg,int32_t& cmd) {
+	if (strstr(arg,"FUNC=")==arg) {
+		_FUNC=getfuncidx(&arg[5]);
+	} else
+	if (strstr(arg,"CMD=")==arg) {
+		if (strstr(&arg[4],"PERIOD")==&arg[4]) {
+			cmd=CMD_PERIOD;
+			if (strstr(arg,",PP")) _PERIODICPOINTS=1;
+			if (strstr(arg,",M2")) _PERIODICITYMETHOD=2;
+			if (strstr(arg,",M3")) _PERIODICITYMETHOD=3;
 		} else
-		if (strstr(argv[i],"CMD=")==argv[i]) {
-			if (strstr(&argv[i][4],"PERIOD")==&argv[i][4]) {
-				cmd=CMD_PERIOD;
-				if (strstr(argv[i],",PP")) _PERIODICPOINTS=1;
-				if (strstr(argv[i],",M2")) _PERIODICITYMETHOD=2;
-				if (strstr(argv[i],",M3")) _PERIODICITYMETHOD=3;
-			} else
-			if (strstr(&argv[i][4],"CONVERT")==&argv[i][4]) {
-				convert_raw_into_newstructure();
-				fclose(flog);
-				return 0;
-			} else
-			if (strstr(&argv[i][4],"FASTDTCHK")==&argv[i][4]) {
-				cmd=CMD_FASTDTCHECK;
-			} 
-		} else 
-		if (strstr(argv[i],"PRECOMPUTE=")) {
-			int a;
-			if (sscanf(&argv[i][11],"%i",&a) == 1) {
-				if (a<1) a=1;
-				_PRECOMPUTEBBXMEMORYGB=a;
+		if (strstr(&arg[4],"CONVERT")==&arg[4]) {
+			cmd=CMD_CONVERT;
+		} else
+		if (strstr(&arg[4],"SWEEP")==&arg[4]) {
+			cmd=CMD_SWEEP;
+		} else
+		if (strstr(&arg[4],"CBOX")==&arg[4]) {
+			cmd=CMD_CBOX;
+		} else
+		if (strstr(&arg[4],"LAYOUTBENCH")==&arg[4]) {
+			cmd=CMD_LAYOUTBENCH;
+		} else
+		if (strstr(&arg[4],"VERIFY")==&arg[4]) {
+			cmd=CMD_VERIFY;
+		} else
+		if (strstr(&arg[4],"FASTDTCHK")==&arg[4]) {
+			cmd=CMD_FASTDTCHECK;
+		} 
+	} else 
+	if (strstr(arg,"PRECOMPUTE=")) {
+		int a;
+		if (sscanf(&arg[11],"%i",&a) == 1) {
+			if (a<1) a=1;
+			_PRECOMPUTEBBXMEMORYGB=a;
+		}
+	} else
+	if (strstr(arg,"VERIFYSLICE=")==arg) {
+		int a,b;
+		if (sscanf(&arg[12],"%i,%i",&a,&b) == 2) {
+			if (b<1) b=1;
+			if ( (a<0) || (a>=b) ) a=0;
+			_VERIFYSLICE=a;
+			_VERIFYSLICES=b;
+		}
+	} else
+	if (strstr(arg,"VGRID=")==arg) {
+		int a,b;
+		int n=sscanf(&arg[6],"%i,%i",&a,&b);
+		if (n >= 1) {
+			if (a<0) a=0;
+			if (a>4) a=4;
+			_VIRTUALGRIDBITS=a;
+		}
+		if (n == 2) {
+			if (b<1) b=1;
+			_SHRINKAGEUSABLE=b;
+		}
+	} else
+	if (strstr(arg,"ORDER=")==arg) {
+		_ORDER=-1;
+		for(int32_t i=0;i<ORDERANZ;i++) {
+			if (!strcmp(&arg[6],ordername[i])) _ORDER=i;
+		}
+		if (_ORDER<0) {
+			LOGMSG2("unknown propagation order %s, RASTER is used\n",&arg[6]);
+			_ORDER=ORDER_RASTER;
+		}
+	} else
+	if (strstr(arg,"BBX=")==arg) {
+		_BBXMETHOD=-1;
+		for(int32_t i=0;i<BBXANZ;i++) {
+			if (!strcmp(&arg[4],bbxname[i])) _BBXMETHOD=i;
+		}
+		if (_BBXMETHOD<0) {
+			LOGMSG2("unknown bounding box method %s, IA is used\n",&arg[4]);
+			_BBXMETHOD=BBX_IA;
+		}
+	} else
+	if (strstr(arg,"WINDOW=")==arg) {
+		double r0,r1,i0,i1; // not NTYP
+		if (sscanf(&arg[7],"%lf,%lf,%lf,%lf",&r0,&r1,&i0,&i1) == 4) {
+			windowre0=(r0 < r1) ? r0 : r1;
+			windowre1=(r0 < r1) ? r1 : r0;
+			windowim0=(i0 < i1) ? i0 : i1;
+			windowim1=(i0 < i1) ? i1 : i0;
+			_WINDOW=1;
+		} else {
+			LOGMSG2("window %s needs re0,re1,im0,im1, not used\n",&arg[7]);
+		}
+	} else
+	if (strstr(arg,"ORACLE=")==arg) {
+		int a;
+		if (sscanf(&arg[7],"%i",&a) == 1) {
+			if (a < 8) {
+				LOGMSG2("oracle level %i below the smallest image, level 8 is used\n",a);
+				a=8;
+			}
+			_ORACLELEVEL=a;
+		}
+	} else
+	if (strstr(arg,"POTWBFS=")==arg) {
+		int a;
+		if (sscanf(&arg[8],"%i",&a) == 1) {
+			if (a<0) a=0;
+			_POTWBFSMEMORYGB=a;
+		}
+	} else
+	if (strstr(arg,"C=")==arg) {
+		double r0,r1,i0,i1; // not NTYP
+		// command line parameters are always considered double no matter the datatype used
+		if (sscanf(&arg[2],"%lf,%lf,%lf,%lf",&r0,&r1,&i0,&i1) == 4) {
+			double w1=floor(r0*DENOM225)/DENOM225;
+			double w2=floor(r1*DENOM225)/DENOM225;
+			if (w1 > w2) {
+				seedC0re=w2;
+				seedC1re=w1;
+				seedC0re_double=w2;
+				seedC1re_double=w1;
+			} else {
+				seedC0re=w1;
+				seedC1re=w2;
+				seedC0re_double=w1;
+				seedC1re_double=w2;
+			}
+			w1=floor(i0*DENOM225)/DENOM225;
+			w2=floor(i1*DENOM225)/DENOM225;
+			if (w1 > w2) {
+				seedC0im=w2;
+				seedC1im=w1;
+				seedC0im_double=w2;
+				seedC1im_double=w1;
+			} else {
+				seedC0im=w1;
+				seedC1im=w2;
+				seedC0im_double=w1;
+				seedC1im_double=w2;
 			}
 		} else
-		if (strstr(argv[i],"C=")==argv[i]) {
-			double r0,r1,i0,i1; // not NTYP
-			// command line parameters are always considered double no matter the datatype used
-			if (sscanf(&argv[i][2],"%lf,%lf,%lf,%lf",&r0,&r1,&i0,&i1) == 4) {
-				double w1=floor(r0*DENOM225)/DENOM225;
-				double w2=floor(r1*DENOM225)/DENOM225;
-				if (w1 > w2) {
-					seedC0re=w2;
-					seedC1re=w1;
-					seedC0re_double=w2;
-					seedC1re_double=w1;
-				} else {
-					seedC0re=w1;
-					seedC1re=w2;
-					seedC0re_double=w1;
-					seedC1re_double=w2;
-				}
-				w1=floor(i0*DENOM225)/DENOM225;
-				w2=floor(i1*DENOM225)/DENOM225;
-				if (w1 > w2) {
-					seedC0im=w2;
-					seedC1im=w1;
-					seedC0im_double=w2;
-					seedC1im_double=w1;
-				} else {
-					seedC0im=w1;
-					seedC1im=w2;
-					seedC0im_double=w1;
-					seedC1im_double=w2;
-				}
-			} else
-			if (sscanf(&argv[i][2],"%lf,%lf",&r0,&i0) == 2) {
-				double ra=floor(r0*DENOM225)/DENOM225;;
-				double ib=floor(i0*DENOM225)/DENOM225;;
-				seedC0re=seedC1re=ra;
-				seedC0im=seedC1im=ib;
-				seedC0re_double=seedC1re_double=ra;
-				seedC0im_double=seedC1im_double=ib;
+		if (sscanf(&arg[2],"%lf,%lf",&r0,&i0) == 2) {
+			double ra=floor(r0*DENOM225)/DENOM225;;
+			double ib=floor(i0*DENOM225)/DENOM225;;
+			seedC0re=seedC1re=ra;
+			seedC0im=seedC1im=ib;
+			seedC0re_double=seedC1re_double=ra;
+			seedC0im_double=seedC1im_double=ib;
+		}
+	} else if (strstr(arg,"CD=")==arg) {
+		int r0,r1,i0,i1; 
+		// command line parameters are always considered double no matter the datatype used
+		if (sscanf(&arg[3],"%i,%i,%i,%i",&r0,&r1,&i0,&i1) == 4) {
+			double w1=(double)r0/DENOM225;
+			double w2=(double)r1/DENOM225;
+			if (w1 > w2) {
+				seedC0re=w2;
+				seedC1re=w1;
+				seedC0re_double=w2;
+				seedC1re_double=w1;
+			} else {
+				seedC0re=w1;
+				seedC1re=w2;
+				seedC0re_double=w1;
+				seedC1re_double=w2;
 			}
-		} else if (strstr(argv[i],"CD=")==argv[i]) {
-			int r0,r1,i0,i1; 
-			// command line parameters are always considered double no matter the datatype used
-			if (sscanf(&argv[i][3],"%i,%i,%i,%i",&r0,&r1,&i0,&i1) == 4) {
-				double w1=(double)r0/DENOM225;
-				double w2=(double)r1/DENOM225;
-				if (w1 > w2) {
-					seedC0re=w2;
-					seedC1re=w1;
-					seedC0re_double=w2;
-					seedC1re_double=w1;
-				} else {
-					seedC0re=w1;
-					seedC1re=w2;
-					seedC0re_double=w1;
-					seedC1re_double=w2;
-				}
-				w1=(double)i0/DENOM225;
-				w2=(double)i1/DENOM225;
-				if (w1 > w2) {
-					seedC0im=w2;
-					seedC1im=w1;
-					seedC0im_double=w2;
-					seedC1im_double=w1;
+			w1=(double)i0/DENOM225;
+			w2=(double)i1/DENOM225;
+			if (w1 > w2) {
+				seedC0im=w2;
+				seedC1im=w1;
+				seedC0im_double=w2;
+				seedC1im_double=w1;
+			} else {
+				seedC0im=w1;
+				seedC1im=w2;
+				seedC0im_double=w1;
+				seedC1im_double=w2;
+			}
+		} else
+		if (sscanf(&arg[3],"%i,%i",&r0,&i0) == 2) {
+			double ra=(double)r0/DENOM225;
+			double ib=(double)i0/DENOM225;;
+			seedC0re=seedC1re=ra;
+			seedC0im=seedC1im=ib;
+			seedC0re_double=seedC1re_double=ra;
+			seedC0im_double=seedC1im_double=ib;
+		}
+	} else if (strstr(arg,"PROP=")==arg) {
+		_PROPAGATEDEF=0;
+		_PROPAGATEPOTW=0;
+
+		if (strstr(arg,"DEF")) _PROPAGATEDEF=1;
+		if (strstr(arg,"POTW")) _PROPAGATEPOTW=1;
+	} else if (strstr(arg,"A=")==arg) {
+		double r0,i0;
+		if (sscanf(&arg[2],"%lf,%lf",&r0,&i0) == 2) {
+			r0=floor(r0*DENOM225)/DENOM225;
+			i0=floor(i0*DENOM225)/DENOM225;
+
+			#ifdef _FPA
+			FAKTORAre.set_double32(r0);
+			FAKTORAim.set_double32(i0);
+			#else
+			FAKTORAre=r0;
+			FAKTORAim=i0;
+			#endif
+
+			FAKTORAre_double=r0;
+			FAKTORAim_double=i0;
+		}
+	} else if (strstr(arg,"AD=")==arg) {
+		int a,b;
+		if (sscanf(&arg[3],"%i,%i",&a,&b) == 2) {
+			double rw=(double)a/DENOM225;
+			double iw=(double)b/DENOM225;
+
+			FAKTORAre=rw;
+			FAKTORAim=iw;
+			FAKTORAre_double=rw;
+			FAKTORAim_double=iw;
+		}
+	} else
+	if (strstr(arg,"LEN=")==arg) {
+		int a;
+		if (sscanf(&arg[4],"%i",&a) == 1) {
+			if (a < 8) a=8;
+			if (a > 31) a=31;
+			SCREENWIDTH=(1 << a);
+		}
+	} else
+	if (strstr(arg,"LEVELS=")==arg) {
+		int a,b;
+		if (sscanf(&arg[7],"%i..%i",&a,&b) == 2) {
+			if (a < 8) a=8;
+			if (b > 31) b=31;
+			if (a <= b) {
+				LEVELFROM=a;
+				LEVELTO=b;
+			}
+			// every intermediate level is saved as raw data and image
+			if (strstr(arg,",SAVE")) _LEVELCHECKPOINT=1;
+		}
+	} else
+	if (strstr(arg,"BLACKGAPS=")==arg) {
+		int a;
+		if (sscanf(&arg[10],"%i",&a) == 1) _BLACKGAPS=(a > 0 ? 1 : 0);
+	} else
+	if (strstr(arg,"RESETPOTW=")==arg) {
+		int a;
+		if (sscanf(&arg[10],"%i",&a) == 1) _RESETPOTW=(a > 0 ? 1 : 0);
+	} else
+	if (strstr(arg,"ESCAPEDISK=")==arg) {
+		int a;
+		if (sscanf(&arg[11],"%i",&a) == 1) _ESCAPEDISK=(a > 0 ? 1 : 0);
+	} else
+	if (strstr(arg,"SYMMETRY=")==arg) {
+		int a;
+		if (sscanf(&arg[9],"%i",&a) == 1) _USESYMMETRY=(a > 0 ? 1 : 0);
+	} else
+	if (strstr(arg,"REVCG=")==arg) {
+		int a;
+		if (sscanf(&arg[6],"%i",&a) == 1) REVCGBITS=a;
+	} else
+	if (strstr(arg,"RANGE=")==arg) {
+		int a;
+		if (sscanf(&arg[6],"%i",&a) == 1) {
+			if (a<0) {
+				// a is a negative exponent
+				double w=1.0 / (double)((int64_t)1 << (-a) );
+				RANGE0=-w;
+				RANGE1=w;
+			} else {
+				RANGE1=makePowerOf2(a);
+				if (RANGE1 != a) LOGMSG2("range adjusted to next-bigger power of 2: %.2lg\n",RANGE1);
+				RANGE0=-RANGE1;
+			}
+			
+			printf("RANGE: %lg\n",RANGE1);
+		}
+	}
+}
+
+// escape radius R for f(z)=z^d+A*z+c (and the 2-iterate of z^2+c,
+// which escapes where z^2+c does): for |z| > R >= 1
+// |f(z)| >= |z|^d - (|A|+|c|)|z| > |z| with R^(d-1) = 1+|A|+|c|, and
+// the ratio |f(z)|/|z| grows along the orbit. |c| is the maximum over
+// the c interval
+void set_escape_radius(void) {
+	escaperadius2=0.0;
+	if (_ESCAPEDISK <= 0) return;
+	
+	int32_t deg=0;
+	switch (_FUNC) {
+		case FUNC_Z2C: deg=2; break;
+		case FUNC_2ITZ2C: deg=2; break;
+		case FUNC_Z3AZC: deg=3; break;
+		case FUNC_Z4AZC: deg=4; break;
+		case FUNC_Z5AZC: deg=5; break;
+		case FUNC_Z6AZC: deg=6; break;
+		case FUNC_Z7AZC: deg=7; break;
+		case FUNC_Z8AZC: deg=8; break;
+	}
+	if (deg <= 0) return;
+	
+	const double cre=maximumdouble(fabs(seedC0re_double),fabs(seedC1re_double));
+	const double cim=maximumdouble(fabs(seedC0im_double),fabs(seedC1im_double));
+	double a=sqrt(cre*cre + cim*cim);
+	if ( (_FUNC != FUNC_Z2C) && (_FUNC != FUNC_2ITZ2C) ) {
+		a += sqrt(FAKTORAre_double*FAKTORAre_double + FAKTORAim_double*FAKTORAim_double);
+	}
+	const double r=pow(1.0+a,1.0/(deg-1));
+	// generous against rounding in the radius and in the test
+	escaperadius2=r*r*(1.0+1E-9);
+	
+	LOGMSG3("escape radius %.4lf (range %.0lf)\n",r,RANGE1);
+}
+
+// computes (or loads) the set for the current parameters and
+// runs the requested command on it
+int32_t run_job(const int32_t cmd) {
+	int32_t c0=clock();
+	
+	COMPLETE0_double=RANGE0;
+	COMPLETE1_double=RANGE1;
+	#ifdef _FPA
+	COMPLETE0.set_vlong(RANGE0);
+	COMPLETE1.set_vlong(RANGE1);
+	#else
+	COMPLETE0=RANGE0;
+	COMPLETE1=RANGE1;
+	#endif
+	set_escape_radius();
+	
+	if (SCREENWIDTH < 256) SCREENWIDTH=256;
+	if (REVCGBITS < 4) REVCGBITS=4;
+	
+	// without LEVELS= the ladder has exactly one rung
+	int32_t level0=(int)ceil(log(SCREENWIDTH)/log(2.0));
+	int32_t level1=level0;
+	if (LEVELFROM>0) {
+		level0=LEVELFROM;
+		level1=LEVELTO;
+		if ( (cmd==CMD_FASTDTCHECK) || (cmd==CMD_VERIFY) ) {
+			// the check only makes sense at one resolution
+			level0=level1;
+		}
+		LOGMSG3("refinement levels %i..%i in memory\n",level0,level1);
+	}
+	if (_WINDOW>0) {
+		if (cmd==CMD_VERIFY) {
+			LOGMSG("Error. cmd=verify needs the whole image, not a window.\n");
+			fatal_exit(99);
+		}
+		if ( (_ORACLELEVEL <= 0) || (_ORACLELEVEL >= level1) ) {
+			LOGMSG("Error. Window mode needs ORACLE=L with L below the level computed.\n");
+			fatal_exit(99);
+		}
+		if (level0 < level1) {
+			LOGMSG2("window mode: only level %i is computed\n",level1);
+			level0=level1;
+		}
+	}
+	const int32_t revcgbits0=REVCGBITS;
+	
+	if (_VIRTUALGRIDBITS>0) {
+		#ifdef _FPA
+		LOGMSG("virtual grid not implemented for FPA, not used\n");
+		_VIRTUALGRIDBITS=0;
+		#else
+		if (_PRECOMPUTEBBXMEMORYGB<=0) {
+			LOGMSG("virtual grid stores into precomputed screen rectangles and needs PRECOMPUTE=N, not used\n");
+			_VIRTUALGRIDBITS=0;
+		}
+		#endif
+	}
+	vgridchecks=VGRIDDEFAULTCHECKS;
+	// setfunc_and_bitprecision adjusts those per function
+	const int64_t clockcount0=checkclockatbbxcount0;
+	const int64_t clockadd=checkclockatbbxadd;
+	
+	// heat-map color table
+	basinpal.setlen(800);
+	basinpal.setInterval(0.0/8.0,1.0/8.0,255,255,0,255,0,0);
+	basinpal.setInterval(1.0/8.0,2.0/8.0,255,255,0,0,255,0);
+	basinpal.setInterval(2.0/8.0,3.0/8.0,0,255,0,0,255,255);
+	basinpal.setInterval(3.0/8.0,4.0/8.0,0,255,255,0,0,255);
+	basinpal.setInterval(4.0/8.0,5.0/8.0,0,0,255,255,0,255);
+	basinpal.setInterval(5.0/8.0,6.0/8.0,255,0,255,255,127,0);
+	basinpal.setInterval(6.0/8.0,7.0/8.0,255,127,0,127,127,255);
+	basinpal.setInterval(7.0/8.0,8.0/8.0,127,127,255,255,255,127);
+	
+	#define CLOCK1 \
+	{\
+		int32_t c1=clock();\
+		LOGMSG2("\nduration %.0lf sec\n",(double)(c1-c0)/CLOCKS_PER_SEC);\
+	}
+	
+	char fn[1024];
+	// image of the previous level, blown up in memory
+	Data5 *coarse=NULL;
+	
+	for(int32_t level=level0;level<=level1;level++) {
+		set_refinement_level(level,revcgbits0);
+		
+		checkclockatbbxcount0=clockcount0;
+		checkclockatbbxadd=clockadd;
+		fn[0]=0;
+		setfunc_and_bitprecision(_FUNC,fn);
+
+		if (fn[0]<=0) {
+			LOGMSG("Error. Name of function not defined.\n");
+			fatal_exit(99);
+		}
+		
+		if (_WINDOW>0) {
+			// the coarse image's name only differs in the level
+			char ofn[1024];
+			const int32_t ofnlen=snprintf(ofn,sizeof(ofn),"_L%02i%s.raw",_ORACLELEVEL,&fn[4]);
+			if ( (ofnlen < 0) || (ofnlen >= (int32_t)sizeof(ofn)) ) {
+				LOGMSG("Error. File name of the coarse image too long.\n");
+				fatal_exit(99);
+			}
+			windoworacle=new WindowOracle;
+			if (windoworacle->read(ofn,level-_ORACLELEVEL) <= 0) {
+				LOGMSG2("Error. Coarse image %s not found or of wrong resolution.\n",ofn);
+				fatal_exit(99);
+			}
+			windoworacle->setWindow(windowre0,windowre1,windowim0,windowim1);
+			sprintf(&fn[strlen(fn)],"_win_%i_%i_%i_%i",
+				windoworacle->x0,windoworacle->x1,
+				windoworacle->y0,windoworacle->y1);
+		}
+		
+		if (level0 < level1) LOGMSG2("\nrefinement level %i\n",level);
+		LOGMSG2("file principal part %s\n",fn);
+		
+		detect_symmetry(level==level0 ? 1 : 0);
+		// checking double needs the image as it is, a window
+		// is in general not symmetric
+		if ( (cmd==CMD_FASTDTCHECK) || (cmd==CMD_VERIFY) || (windoworacle) ) _SYMMETRY=0;
+		if (windoworacle) {
+			LOGMSG5("window: pixels [%i..%i] x [%i..%i]\n",
+				windoworacle->x0,windoworacle->x1,
+				windoworacle->y0,windoworacle->y1);
+			LOGMSG3("  tiles of %i pixels, coarse pixels of %i\n",
+				REVCGBLOCKWIDTH,1 << windoworacle->shift);
+		}
+		
+		if (!parentmgr) parentmgr=new ParentManager;
+		data5=new Data5;
+
+		PlaneRect plane;
+		
+		if (windoworacle) {
+			// _in.raw is not read, the window starts from the coarse image
+			data5->setupWindow();
+			plane.x0=windoworacle->x0 * scaleRangePerPixel + COMPLETE0;
+			plane.x1=(windoworacle->x1+1) * scaleRangePerPixel + COMPLETE0;
+			plane.y0=windoworacle->y0 * scaleRangePerPixel + COMPLETE0;
+			plane.y1=(windoworacle->y1+1) * scaleRangePerPixel + COMPLETE0;
+		} else
+		if (coarse) {
+			data5->refineFrom(coarse);
+			delete coarse;
+			coarse=NULL;
+			// add/substract 16 for safetly
+			plane.x0=(encgrayx0-16) * scaleRangePerPixel + COMPLETE0;
+			plane.x1=(encgrayx1+16) * scaleRangePerPixel + COMPLETE0;
+			plane.y0=(encgrayy0-16) * scaleRangePerPixel + COMPLETE0;
+			plane.y1=(encgrayy1+16) * scaleRangePerPixel + COMPLETE0;
+		} else
+		// if raw data file exists: read it and if necessary blow up the pixels 2fold
+		// sweep jobs always start anew, except for verifying
+		if ( 
+			( (_FRESHSTART>0) && (cmd!=CMD_VERIFY) ) ||
+			(data5->readRawBlowUp() <= 0)
+		) {
+			if (cmd==CMD_VERIFY) {
+				LOGMSG("Error. cmd=verify needs the image as _in.raw.\n");
+				fatal_exit(99);
+			}
+			// data5 object is - no matter what data it holds - considered uninitialised
+			printf("searching for special exterior ... ");
+
+			encgrayx0=encgrayy0=0;
+			encgrayx1=encgrayy1=SCREENWIDTH-16;
+			planegrayx0=planegrayy0=COMPLETE0;
+			planegrayx1=planegrayy1=COMPLETE1;
+			plane.x0=COMPLETE0;
+			plane.x1=COMPLETE1;
+			plane.y0=COMPLETE0;
+			plane.y1=COMPLETE1;
+
+			int32_t MEMWIDTH=(SCREENWIDTH >> 4);
+			for(int32_t y=0;y<SCREENWIDTH;y++) {
+				if ( (_SYMMETRY>0) && (y >= (SCREENWIDTH >> 1)) ) {
+					// mirrored row shares the memory
+					data5->zeilen[y]=data5->zeilen[SCREENWIDTH-1-y];
 				} else {
-					seedC0im=w1;
-					seedC1im=w2;
-					seedC0im_double=w1;
-					seedC1im_double=w2;
+					data5->zeilen[y]=data5->datamgr->getMemory(MEMWIDTH);
 				}
-			} else
-			if (sscanf(&argv[i][3],"%i,%i",&r0,&i0) == 2) {
-				double ra=(double)r0/DENOM225;
-				double ib=(double)i0/DENOM225;;
-				seedC0re=seedC1re=ra;
-				seedC0im=seedC1im=ib;
-				seedC0re_double=seedC1re_double=ra;
-				seedC0im_double=seedC1im_double=ib;
 			}
-		} else if (strstr(argv[i],"PROP=")==argv[i]) {
-			_PROPAGATEDEF=0;
-			_PROPAGATEPOTW=0;
-
-			if (strstr(argv[i],"DEF")) _PROPAGATEDEF=1;
-			if (strstr(argv[i],"POTW")) _PROPAGATEPOTW=1;
-		} else if (strstr(argv[i],"A=")==argv[i]) {
-			double r0,i0;
-			if (sscanf(&argv[i][2],"%lf,%lf",&r0,&i0) == 2) {
-				r0=floor(r0*DENOM225)/DENOM225;
-				i0=floor(i0*DENOM225)/DENOM225;
 
-				#ifdef _FPA
-				FAKTORAre.set_double32(r0);
-				FAKTORAim.set_double32(i0);
-				#else
-				FAKTORAre=r0;
-				FAKTORAim=i0;
-				#endif
+			// squares whose bounding box lies completely in the special exterior
+			find_special_exterior_hitting_squares();
+			// whole rows were allocated, spans follow the gray now
+			data5->tightenRows(1);
+		} else {
+			// add/substract 16 for safetly
+			plane.x0=(encgrayx0-16) * scaleRangePerPixel + COMPLETE0;
+			plane.x1=(encgrayx1+16) * scaleRangePerPixel + COMPLETE0;
+			plane.y0=(encgrayy0-16) * scaleRangePerPixel + COMPLETE0;
+			plane.y1=(encgrayy1+16) * scaleRangePerPixel + COMPLETE0;
+		}
+		
+		if (_SYMMETRY>0) {
+			data5->foldSymmetric();
+			printf("  propagating lower half only\n");
+		}
+		
+		#ifdef _FPA
+		LOGMSG5("  roughly %.20lg..%.20lg x %.5lg..%.5lg used\n",
+			plane.x0.convert_to_double(),
+			plane.x1.convert_to_double(),
+			plane.y0.convert_to_double(),
+			plane.y1.convert_to_double());
+		#else
+		LOGMSG5("  roughly %.20lg..%.20lg x %.20lg..%.20lg used\n",
+			(double)plane.x0,(double)plane.x1,(double)plane.y0,(double)plane.y1);
+		#endif
+		
+		if (
+			(encgrayx0 > (SCREENWIDTH >> 2) ) &&
+			(encgrayx1 < (3*(SCREENWIDTH >> 2) ) ) &&
+			(encgrayy0 > (SCREENWIDTH >> 2) ) &&
+			(encgrayy1 < (3*(SCREENWIDTH >> 2) ) ) 
+		) {
+			LOGMSG5("  gray in pixel region [%i..%i] x [%i..%i]\n",
+				encgrayx0,encgrayx1,encgrayy0,encgrayy1);
+			LOGMSG("  range could be adjusted (half is enough)\n");
+		}
+		
+		if (level==level0) {
+			char tmp[4096];
+			fprintf(flog,"%s * 2^-%i\n",seedCstr225(tmp),BASEDENOMINATOR);
+			fprintf(flog,"(if needed): %s * 2^-%i\n",FAKTORAstr225(tmp),BASEDENOMINATOR);
+		}
+		
+		if (cmd==CMD_VERIFY) {
+			// no helpers: the image is checked with the kernel the
+			// propagation did not use
+			char tt[2048];
+			if (_VERIFYSLICES>1) {
+				LOGMSG3("verifying block rows %i mod %i ... ",_VERIFYSLICE,_VERIFYSLICES);
+				sprintf(tt,"__L%i_verify_%i_of_%i",REFINEMENTLEVEL,_VERIFYSLICE,_VERIFYSLICES);
+			} else {
+				printf("verifying white and black pixels ... ");
+				sprintf(tt,"__L%i_verify",REFINEMENTLEVEL);
+			}
+			const int8_t passed=verify_image();
+			strcat(tt,(passed > 0) ? "_PASSED" : "_FAILED");
+			if (passed > 0) {
+				LOGMSG("  PASSED: every white pixel escapes, every black pixel keeps its color\n");
+			} else {
+				LOGMSG("  FAILED.\n");
+			}
+			FILE *f=fopen(tt,"wt");
+			if (f) {
+				fprintf(f,"%s\n",(passed > 0) ? "PASSED" : "FAILED");
+				fclose(f);
+			}
+			CLOCK1
+			
+			return 0;
+		}
+		
+		if (!getBoundingBoxfA_helper) {
+			LOGMSG("Error. No helper bbx function defined.\n");
+			fatal_exit(99);
+		}
+		if (helpermgr) helpermgr->rewind();
+		else helpermgr=new HelperManager;
+		helperYdep=new HelperAccess;
+		helperXdep=new HelperAccess;
+		helperYdep->initMemory();
+		helperXdep->initMemory();
+		printf("precomputing sub-expressions ... Y ");
+		helperYdep->precompute(DIRECTIONY);
+		printf("X\n");
+		helperXdep->precompute(DIRECTIONX);
+
+		if (cmd==CMD_FASTDTCHECK) {
+			// compute respective _double variants
+			helper_doublemgr=new Helper_doubleManager;
+			helperYdep_double=new HelperAccess_double;
+			helperXdep_double=new HelperAccess_double;
+			helperYdep_double->initMemory();
+			helperXdep_double->initMemory();
+			printf("precomputing number type double sub-expressions ... Y ");
+			helperYdep_double->precompute(DIRECTIONY);
+			printf("X ");
+			helperXdep_double->precompute(DIRECTIONX);
+			printf("\n");
+		}
+		
+		if (cmd==CMD_FASTDTCHECK) {
+			printf("checking if double can be used instead of %s ... ",NNTYPSTR);
+			char tt[2048];
+			if (fastdtcheck_double() > 0) {
+				LOGMSG("\n  PASSED: At current formula/parameters/level, number type 'double' results in correct screenRects\n");
+				sprintf(tt,"__L%i_fastdtcheck_PASSED",REFINEMENTLEVEL);
+				FILE *f=fopen(tt,"wt");
+				fprintf(f,"\n  Checking DOUBLE against sufficient %s type\n",NNTYPSTR);
+				fprintf(f,"\n  PASSED: At current formula/parameters/level number type 'double' results in correct screenRects\n");
+				fclose(f);
+			} else {
+				LOGMSG("\n  FAILED. Using double is discouraged due to rounding errors.\n");
+				sprintf(tt,"__L%i_fastdtcheck_FAILED",REFINEMENTLEVEL);
+				FILE *f=fopen(tt,"wt");
+				fprintf(f,"\n  Checking DOUBLE against sufficient %s type\n",NNTYPSTR);
+				fprintf(f,"\n  FAILED. Using double is discouraged due to rounding errors.\n");
+				fclose(f);
+			}
+			CLOCK1
+			
+			// dirty exit
+			return 0;
+		}
+
+		// if paramter provided => bbx can be precomputed uop
+		// to a certain memory consumption
+		if (_PRECOMPUTEBBXMEMORYGB>0) {
+			data5->precomputeScreenRect();
+		}
+		
+		int64_t vgridgray=0;
+		const int64_t vgridbbx0=ctrbbxfa;
+		ctrpcscrchecks=0;
+		if (_VIRTUALGRIDBITS>0) vgridgray=count_gray_pixels();
+		
+		// //////////////////////////////////////
+		compute(); 
+		// //////////////////////////////////////
+		
+		// the next level's cost model
+		if (vgridgray > 0) {
+			vgridchecks=(double)(ctrbbxfa-vgridbbx0+ctrpcscrchecks) / vgridgray;
+		}
 
-				FAKTORAre_double=r0;
-				FAKTORAim_double=i0;
-			}
-		} else if (strstr(argv[i],"AD=")==argv[i]) {
-			int a,b;
-			if (sscanf(&argv[i][3],"%i,%i",&a,&b) == 2) {
-				double rw=(double)a/DENOM225;
-				double iw=(double)b/DENOM225;
-
-				FAKTORAre=rw;
-				FAKTORAim=iw;
-				FAKTORAre_double=rw;
-				FAKTORAim_double=iw;
-			}
-		} else
-		if (strstr(argv[i],"LEN=")==argv[i]) {
-			int a;
-			if (sscanf(&argv[i][4],"%i",&a) == 1) {
-				if (a < 8) a=8;
-				if (a > 31) a=31;
-				SCREENWIDTH=(1 << a);
+		if (interiorpresent>0) {
+			LOGMSG("\nINTERIOR present\n");
+		}
+		
+		// intermediate levels are only kept in memory unless
+		// checkpoints are requested
+		if ( (level==level1) || (_LEVELCHECKPOINT>0) ) {
+			// storing raw data, a window's would read as a
+			// full image white outside the window
+			if (windoworacle) {
+				printf("window mode: raw data not saved\n");
+			} else {
+				printf("saving raw data ... ");
+				data5->saveRaw(fn);
+				sprintf(SAVEDRAWFN,"%s.raw",fn);
+				printf("done\n");
 			}
-		} else
-		if (strstr(argv[i],"REVCG=")==argv[i]) {
-			int a;
-			if (sscanf(&argv[i][6],"%i",&a) == 1) REVCGBITS=a;
-		} else
-		if (strstr(argv[i],"RANGE=")==argv[i]) {
-			int a;
-			if (sscanf(&argv[i][6],"%i",&a) == 1) {
-				if (a<0) {
-					// a is a negative exponent
-					double w=1.0 / (double)((int64_t)1 << (-a) );
-					RANGE0=-w;
-					RANGE1=w;
+
+			// storing a trustworthily downscaled image
+			if (SAVEIMAGE>0) {
+				if (SCREENWIDTH > 65536) {
+					printf("\nsaving trustworthily downscaled image ... ");
 				} else {
-					RANGE1=makePowerOf2(a);
-					if (RANGE1 != a) LOGMSG2("range adjusted to next-bigger power of 2: %.2lg\n",RANGE1);
-					RANGE0=-RANGE1;
+					printf("\nsaving image ... ");
 				}
-				
-				printf("RANGE: %lg\n",RANGE1);
+				data5->saveBitmap4_twd(fn,-1);
 			}
 		}
-	} // i
+		
+		//followallgray(fn);
+
+		// free memory to get enough to allocate for the periodicty check
+		// or the next refinement level
+		printf("freeing non-image memory ...\n");
+		freeRevCGMem();
+		data5->tightenRows(0);
+		int64_t released=data5->compactMemory();
+		if (released > 0) printf("  compaction released %I64d MB\n",released >> 20);
+
+		if (data5->pcscr) {
+			delete[] data5->pcscr;
+			data5->pcscr=NULL;
+		}
+		if (data5->pcscrmgr) {
+			// frees the allocated screenrects
+			delete data5->pcscrmgr;
+			data5->pcscrmgr=NULL;
+		}
+		
+		if (level == level1) {
+			jobsummary.interior=interiorpresent;
+			jobsummary.gray=count_gray_pixels();
+		} else {
+			// helpers depend on the resolution, their memory is reused
+			delete helperYdep;
+			delete helperXdep;
+			helperYdep=helperXdep=NULL;
+			
+			coarse=data5;
+			data5=NULL;
+			CLOCK1
+		}
+	} // level
+
+	// data is now computed or loaded
+	if ( (cmd==CMD_PERIOD) && (windoworacle) ) {
+		LOGMSG("Periodicity check needs the whole image, skipped in window mode.\n");
+	} else
+	if (cmd==CMD_PERIOD) {
+		if (_SYMMETRY>0) data5->unfoldSymmetric();
+		if (_BLACKGAPS>0) data5->storeBlackGaps();
+		if (interiorpresent>0) {
+			if (_PERIODICITYMETHOD==3) {
+				periodicity_m3(fn);
+				// data is no longer valid as potw has
+				// a different meaning there
+			} else {
+				periodicity(fn);
+			}
+		} else {
+			LOGMSG("No interior present. Periodicity check skipped.\n");
+			jobsummary.anzcycles=0;
+		}
+	} else
+	if (cmd==CMD_LAYOUTBENCH) {
+		layout_benchmark();
+	}
 	
-	COMPLETE0_double=RANGE0;
-	COMPLETE1_double=RANGE1;
-	#ifdef _FPA
-	COMPLETE0.set_vlong(RANGE0);
-	COMPLETE1.set_vlong(RANGE1);
-	#else
-	COMPLETE0=RANGE0;
-	COMPLETE1=RANGE1;
-	#endif
+	delete data5;
+	data5=NULL;
 	
-	if (SCREENWIDTH < 256) SCREENWIDTH=256;
-	if (REVCGBITS < 4) REVCGBITS=4;
+	CLOCK1
+	jobsummary.sec=(double)(clock()-c0)/CLOCKS_PER_SEC;
 	
-	REFINEMENTLEVEL=(int)ceil(log(SCREENWIDTH)/log(2.0));
+	LOGMSG2("%I64d bounding boxes calculated\n",ctrbbxfa);
 	
-	// SCREENWIDTH / (2^REVCGBITS) <= 2^15
-	// REVCG allocated en bloc => adjust REVCGBITS
-	// revcg-Parents numbered with 16 bit
-	while ( (SCREENWIDTH >> REVCGBITS) > (1 << 15)) REVCGBITS++;
-
-	REVCGBLOCKWIDTH=(1 << REVCGBITS);
-	if (SCREENWIDTH >= REVCGBLOCKWIDTH) {
-		REVCGmaxnumber=SCREENWIDTH >> REVCGBITS;
-	} else REVCGmaxnumber=1;
-	REVCGmaxnumberQ=REVCGmaxnumber*REVCGmaxnumber;
+	free_job_memory();
 	
-	char fn[1024];
-	fn[0]=0;
-	setfunc_and_bitprecision(_FUNC,fn);
+	return 0;
+}
 
-	if (fn[0]<=0) {
-		LOGMSG("Error. Name of function not defined.\n");
-		exit(99);
+// frees everything a job allocated. Also used after an error inside
+// a job. The arenas of the bound engine stay allocated for its next job
+void free_job_memory(void) {
+	if (data5) {
+		delete data5;
+		data5=NULL;
 	}
+	if (windoworacle) {
+		delete windoworacle;
+		windoworacle=NULL;
+	}
+	if (parentmgr) {
+		if (activeengine) parentmgr->rewind();
+		else {
+			delete parentmgr;
+			parentmgr=NULL;
+		}
+	}
+	if ( (!activeengine) && (helpermgr) ) {
+		delete helpermgr;
+		helpermgr=NULL;
+	}
+	if (helperYdep) delete helperYdep;
+	if (helperXdep) delete helperXdep;
+	helperYdep=helperXdep=NULL;
+	if (helper_doublemgr) delete helper_doublemgr;
+	if (helperYdep_double) delete helperYdep_double;
+	if (helperXdep_double) delete helperXdep_double;
+	helper_doublemgr=NULL;
+	helperYdep_double=helperXdep_double=NULL;
 	
-	LOGMSG2("file principal part %s\n",fn);
-	
-	data5=new Data5;
+	if (cycles) {
+		delete[] cycles;
+		cycles=NULL;
+	}
+	if (ibfcomponents) {
+		delete[] ibfcomponents;
+		ibfcomponents=NULL;
+	}
+}
 
-	double w=(RANGE1-RANGE0) / (double)SCREENWIDTH;
-	scaleRangePerPixel=w;
-	scaleRangePerPixel_double=w;
+// errors inside JuliaEngine::run only end the job, otherwise the process
+void fatal_exit(const int32_t code) {
+	if (activeengine) {
+		EngineError err;
+		err.code=code;
+		throw err;
+	}
+	exit(code);
+}
 
-	w=(double)SCREENWIDTH / (RANGE1-RANGE0);
-	scalePixelPerRange=w;
-	scalePixelPerRange_double=w;
-	// w is a power of 2
-	scalePixelPerRangeExponent=getPower2Exponent( (uint64_t)w );
-	
-	// heat-map color table
-	basinpal.setlen(800);
-	basinpal.setInterval(0.0/8.0,1.0/8.0,255,255,0,255,0,0);
-	basinpal.setInterval(1.0/8.0,2.0/8.0,255,255,0,0,255,0);
-	basinpal.setInterval(2.0/8.0,3.0/8.0,0,255,0,0,255,255);
-	basinpal.setInterval(3.0/8.0,4.0/8.0,0,255,255,0,0,255);
-	basinpal.setInterval(4.0/8.0,5.0/8.0,0,0,255,255,0,255);
-	basinpal.setInterval(5.0/8.0,6.0/8.0,255,0,255,255,127,0);
-	basinpal.setInterval(6.0/8.0,7.0/8.0,255,127,0,127,127,255);
-	basinpal.setInterval(7.0/8.0,8.0/8.0,127,127,255,255,255,127);
+// JuliaEngine
+
+JuliaEngine::JuliaEngine() {
+	anzparam=0;
+	freshstart=0;
+	strcpy(tempfn,"_temp");
+	strcpy(infn,"_in.raw");
+	rawfn[0]=0;
+	memset(&summary,0,sizeof(summary));
+	keptparentmgr=NULL;
+	kepthelpermgr=NULL;
+	keptdatamgr=NULL;
+}
+
+JuliaEngine::~JuliaEngine() {
+	if (keptparentmgr) delete keptparentmgr;
+	if (kepthelpermgr) delete kepthelpermgr;
+	if (keptdatamgr) delete keptdatamgr;
+}
+
+void JuliaEngine::clearParameters(void) {
+	anzparam=0;
+}
+
+// one or more whitespace-separated KEY=value parameters,
+// returns the number of parameters stored
+int32_t JuliaEngine::addParameter(const char* s) {
+	int32_t added=0;
 	
-	PlaneRect plane;
+	while (*s) {
+		while ( (*s==' ') || (*s=='\t') ) s++;
+		int32_t len=0;
+		while ( (s[len]) && (s[len]!=' ') && (s[len]!='\t') ) len++;
+		if (len<=0) break;
+		if (
+			(anzparam >= MAXENGINEPARAMS) ||
+			(len >= MAXENGINEPARAMLEN)
+		) {
+			LOGMSG("Error. Too many or too long engine parameters.\n");
+			return added;
+		}
+		
+		memcpy(param[anzparam],s,len);
+		param[anzparam][len]=0;
+		upper(param[anzparam]);
+		anzparam++;
+		added++;
+		s += len;
+	}
 	
-	// if raw data file exists: read it and if necessary blow up the pixels 2fold
-	if (data5->readRawBlowUp() <= 0) {
-		// data5 object is - no matter what data it holds - considered uninitialised
-		printf("searching for special exterior ... ");
+	return added;
+}
 
-		encgrayx0=encgrayy0=0;
-		encgrayx1=encgrayy1=SCREENWIDTH-16;
-		planegrayx0=planegrayy0=COMPLETE0;
-		planegrayx1=planegrayy1=COMPLETE1;
-		plane.x0=COMPLETE0;
-		plane.x1=COMPLETE1;
-		plane.y0=COMPLETE0;
-		plane.y1=COMPLETE1;
+// moves the engine's state into the (thread's) globals
+void JuliaEngine::bind(void) {
+	activeengine=this;
+	_FRESHSTART=freshstart;
+	strcpy(TEMPFN,tempfn);
+	strcpy(INFN,infn);
+	SAVEDRAWFN[0]=0;
+	
+	parentmgr=keptparentmgr;
+	if (!parentmgr) parentmgr=new ParentManager;
+	helpermgr=kepthelpermgr;
+	sparedatamgr=keptdatamgr;
+	keptparentmgr=NULL;
+	kepthelpermgr=NULL;
+	keptdatamgr=NULL;
+}
 
-		int32_t MEMWIDTH=(SCREENWIDTH >> 4);
-		for(int32_t y=0;y<SCREENWIDTH;y++) {
-			data5->zeilen[y]=data5->datamgr->getMemory(MEMWIDTH);
-		}
+void JuliaEngine::unbind(void) {
+	keptparentmgr=parentmgr;
+	kepthelpermgr=helpermgr;
+	keptdatamgr=sparedatamgr;
+	parentmgr=NULL;
+	helpermgr=NULL;
+	sparedatamgr=NULL;
+	
+	_FRESHSTART=0;
+	strcpy(INFN,"_in.raw");
+	activeengine=NULL;
+}
 
-		// squares whose bounding box lies completely in the special exterior
-		find_special_exterior_hitting_squares();
-	} else {
-		// add/substract 16 for safetly
-		plane.x0=(encgrayx0-16) * scaleRangePerPixel + COMPLETE0;
-		plane.x1=(encgrayx1+16) * scaleRangePerPixel + COMPLETE0;
-		plane.y0=(encgrayy0-16) * scaleRangePerPixel + COMPLETE0;
-		plane.y1=(encgrayy1+16) * scaleRangePerPixel + COMPLETE0;
+// computes one job with the stored parameters. Returns 0 or the code
+// the stand-alone program would have exited with.
+// The result is in summary
+int32_t JuliaEngine::run(void) {
+	if (activeengine) {
+		LOGMSG("Error. Another engine is running on this thread.\n");
+		return 99;
 	}
 	
-	#ifdef _FPA
-	LOGMSG5("  roughly %.20lg..%.20lg x %.5lg..%.5lg used\n",
-		plane.x0.convert_to_double(),
-		plane.x1.convert_to_double(),
-		plane.y0.convert_to_double(),
-		plane.y1.convert_to_double());
-	#else
-	LOGMSG5("  roughly %.20lg..%.20lg x %.20lg..%.20lg used\n",
-		(double)plane.x0,(double)plane.x1,(double)plane.y0,(double)plane.y1);
-	#endif
+	bind();
 	
-	if (
-		(encgrayx0 > (SCREENWIDTH >> 2) ) &&
-		(encgrayx1 < (3*(SCREENWIDTH >> 2) ) ) &&
-		(encgrayy0 > (SCREENWIDTH >> 2) ) &&
-		(encgrayy1 < (3*(SCREENWIDTH >> 2) ) ) 
+	set_default_parameters();
+	int32_t cmd=CMD_CALC;
+	for(int32_t i=0;i<anzparam;i++) {
+		parse_parameter(param[i],cmd);
+	}
+	
+	jobsummary.interior=0;
+	jobsummary.gray=0;
+	jobsummary.anzcycles=-1; // not checked
+	jobsummary.sec=0;
+	int64_t bbx0=ctrbbxfa;
+	interiorpresent=0;
+	
+	int32_t ret=0;
+	if ( 
+		(cmd==CMD_CONVERT) ||
+		(cmd==CMD_SWEEP) ||
+		(cmd==CMD_CBOX)
 	) {
-		LOGMSG5("  gray in pixel region [%i..%i] x [%i..%i]\n",
-			encgrayx0,encgrayx1,encgrayy0,encgrayy1);
-		LOGMSG("  range could be adjusted (half is enough)\n");
+		LOGMSG("Error. Command cannot be run by an engine.\n");
+		ret=99;
+	} else {
+		try {
+			run_job(cmd);
+		} catch (EngineError& err) {
+			LOGMSG2("job aborted (code %i)\n",err.code);
+			ret=err.code;
+		}
 	}
 	
-	char tmp[4096];
-	fprintf(flog,"%s * 2^-%i\n",seedCstr225(tmp),BASEDENOMINATOR);
-	fprintf(flog,"(if needed): %s * 2^-%i\n",FAKTORAstr225(tmp),BASEDENOMINATOR);
+	// also after cmd=fastdtchk or an error
+	free_job_memory();
 	
-	#define CLOCK1 \
-	{\
-		int32_t c1=clock();\
-		LOGMSG2("\nduration %.0lf sec\n",(double)(c1-c0)/CLOCKS_PER_SEC);\
-	}
+	jobsummary.level=REFINEMENTLEVEL;
+	jobsummary.bbx=ctrbbxfa-bbx0;
+	summary=jobsummary;
+	strcpy(rawfn,SAVEDRAWFN);
 	
-	if (!getBoundingBoxfA_helper) {
-		LOGMSG("Error. No helper bbx function defined.\n");
-		exit(99);
-	}
-	helpermgr=new HelperManager;
-	helperYdep=new HelperAccess;
-	helperXdep=new HelperAccess;
-	helperYdep->initMemory();
-	helperXdep->initMemory();
-	printf("precomputing sub-expressions ... Y ");
-	helperYdep->precompute(DIRECTIONY);
-	printf("X\n");
-	helperXdep->precompute(DIRECTIONX);
-
-	if (cmd==CMD_FASTDTCHECK) {
-		// compute respective _double variants
-		helper_doublemgr=new Helper_doubleManager;
-		helperYdep_double=new HelperAccess_double;
-		helperXdep_double=new HelperAccess_double;
-		helperYdep_double->initMemory();
-		helperXdep_double->initMemory();
-		printf("precomputing number type double sub-expressions ... Y ");
-		helperYdep_double->precompute(DIRECTIONY);
-		printf("X ");
-		helperXdep_double->precompute(DIRECTIONX);
-		printf("\n");
+	unbind();
+	
+	return ret;
+}
+
+// jobs of one sweep, shared by its engines
+struct SweepJobs {
+	char** line;
+	int32_t anz;
+	int32_t next; // first job not yet taken
+	char common[4096]; // command line parameters for all jobs
+	FILE* fsum;
+	#ifdef _MULTIENGINE
+	std::mutex lock;
+	#endif
+};
+
+// cycle lengths of a job as comma separated list, - if not checked
+void summary_cycles(const JobSummary& sum,char* erg) {
+	if (sum.anzcycles<0) {
+		sprintf(erg,"-");
+		return;
 	}
 	
-	if (cmd==CMD_FASTDTCHECK) {
-		printf("checking if double can be used instead of %s ... ",NNTYPSTR);
-		char tt[2048];
-		if (fastdtcheck_double() > 0) {
-			LOGMSG("\n  PASSED: At current formula/parameters/level, number type 'double' results in correct screenRects\n");
-			sprintf(tt,"__L%i_fastdtcheck_PASSED",REFINEMENTLEVEL);
-			FILE *f=fopen(tt,"wt");
-			fprintf(f,"\n  Checking DOUBLE against sufficient %s type\n",NNTYPSTR);
-			fprintf(f,"\n  PASSED: At current formula/parameters/level number type 'double' results in correct screenRects\n");
-			fclose(f);
-		} else {
-			LOGMSG("\n  FAILED. Using double is discouraged due to rounding errors.\n");
-			sprintf(tt,"__L%i_fastdtcheck_FAILED",REFINEMENTLEVEL);
-			FILE *f=fopen(tt,"wt");
-			fprintf(f,"\n  Checking DOUBLE against sufficient %s type\n",NNTYPSTR);
-			fprintf(f,"\n  FAILED. Using double is discouraged due to rounding errors.\n");
-			fclose(f);
+	erg[0]=0;
+	for(int32_t i=0;i<sum.anzcycles;i++) {
+		if (i >= MAXSUMMARYCYCLES) {
+			strcat(erg,",..");
+			break;
 		}
-		CLOCK1
-		
-		// dirty exit
-		return 0;
+		sprintf(&erg[strlen(erg)],"%s%i",(i>0 ? "," : ""),sum.cyclelen[i]);
 	}
+	if (sum.anzcycles==0) sprintf(erg,"0");
+}
 
-	// if paramter provided => bbx can be precomputed uop
-	// to a certain memory consumption
-	if (_PRECOMPUTEBBXMEMORYGB>0) {
-		data5->precomputeScreenRect();
-	}
+// one engine working off sweep jobs until none are left
+void sweep_worker(SweepJobs* jobs,const int32_t threadnr) {
+	JuliaEngine engine;
+	engine.freshstart=1;
+	// intermediate saves of concurrent engines must not collide
+	if (threadnr>0) sprintf(engine.tempfn,"_temp_t%i",threadnr);
 	
-	// //////////////////////////////////////
-	compute(); 
-	// //////////////////////////////////////
+	while (1) {
+		#ifdef _MULTIENGINE
+		jobs->lock.lock();
+		#endif
+		int32_t job=jobs->next++;
+		#ifdef _MULTIENGINE
+		jobs->lock.unlock();
+		#endif
+		if (job >= jobs->anz) break;
+		
+		LOGMSG3("\n=== sweep job %i: %s\n",job+1,jobs->line[job]);
+		
+		engine.clearParameters();
+		engine.addParameter(jobs->common);
+		engine.addParameter(jobs->line[job]);
+		
+		int32_t ret=engine.run();
+		JobSummary& sum=engine.summary;
+		
+		char cyc[1024];
+		summary_cycles(sum,cyc);
+		
+		#ifdef _MULTIENGINE
+		jobs->lock.lock();
+		#endif
+		fprintf(jobs->fsum,"%i\t%s\tL%02i\tinterior=%i\tgray=%I64d\tcycles=%s\tsec=%.1lf\tbbx=%I64d",
+			job+1,jobs->line[job],sum.level,
+			sum.interior,sum.gray,cyc,
+			sum.sec,sum.bbx);
+		if (ret != 0) fprintf(jobs->fsum,"\terror=%i",ret);
+		fprintf(jobs->fsum,"\n");
+		fflush(jobs->fsum);
+		#ifdef _MULTIENGINE
+		jobs->lock.unlock();
+		#endif
+	} // while
+}
 
-	if (interiorpresent>0) {
-		LOGMSG("\nINTERIOR present\n");
+// cmd=sweep,FILE: every non-empty line of FILE holds the parameters of
+// one job in command line syntax, parameters given on the command line
+// itself apply to all jobs. The jobs are run by one JuliaEngine in this
+// process which keeps image, parent and helper memory between jobs.
+// With _MULTIENGINE, THREADS=n distributes the jobs over n engines.
+// One summary line per job is appended to _sweep_summary.txt
+void run_sweep(const char* afn,int32_t argc,char** argv) {
+	FILE *fin=fopen(afn,"rt");
+	if (!fin) {
+		LOGMSG2("Error. Sweep file %s not found.\n",afn);
+		fatal_exit(99);
 	}
 	
-	// storing raw data
-	printf("saving raw data ... ");
-	data5->saveRaw(fn);
-	printf("done\n");
-
-	// storing a trustworthily downscaled image
-	if (SAVEIMAGE>0) {
-		if (SCREENWIDTH > 65536) {
-			printf("\nsaving trustworthily downscaled image ... ");
-		} else {
-			printf("\nsaving image ... ");
+	SweepJobs *jobs=new SweepJobs;
+	jobs->anz=0;
+	jobs->next=0;
+	jobs->common[0]=0;
+	int32_t threads=1;
+	
+	// arguments are already upper case
+	for(int32_t i=1;i<argc;i++) {
+		if (strstr(argv[i],"CMD=SWEEP")==argv[i]) continue;
+		if (strstr(argv[i],"THREADS=")==argv[i]) {
+			int a;
+			if (sscanf(&argv[i][8],"%i",&a) == 1) threads=a;
+			continue;
+		}
+		if ( (strlen(jobs->common)+strlen(argv[i])) > 4000) break;
+		strcat(jobs->common," ");
+		strcat(jobs->common,argv[i]);
+	}
+	
+	char line[4096];
+	int32_t memjobs=256;
+	jobs->line=new char*[memjobs];
+	
+	while (fgets(line,4000,fin)) {
+		char *p=strchr(line,'\n');
+		if (p) *p=0;
+		p=strchr(line,'\r');
+		if (p) *p=0;
+		if ( (line[0]==0) || (line[0]=='#') ) continue;
+		
+		if (jobs->anz >= memjobs) {
+			char** tmp=new char*[2*memjobs];
+			memcpy(tmp,jobs->line,memjobs*sizeof(char*));
+			delete[] jobs->line;
+			jobs->line=tmp;
+			memjobs *= 2;
+		}
+		jobs->line[jobs->anz]=new char[strlen(line)+1];
+		strcpy(jobs->line[jobs->anz],line);
+		jobs->anz++;
+	} // while
+	fclose(fin);
+	
+	jobs->fsum=fopen("_sweep_summary.txt","at");
+	
+	if (threads > jobs->anz) threads=jobs->anz;
+	if (threads < 1) threads=1;
+	
+	#ifdef _MULTIENGINE
+	if (threads>1) {
+		LOGMSG2("%i engines working concurrently\n",threads);
+		std::thread** worker=new std::thread*[threads];
+		for(int32_t t=0;t<threads;t++) {
+			worker[t]=new std::thread(sweep_worker,jobs,t+1);
 		}
-		data5->saveBitmap4_twd(fn,-1);
+		for(int32_t t=0;t<threads;t++) {
+			worker[t]->join();
+			delete worker[t];
+		}
+		delete[] worker;
+	} else sweep_worker(jobs,0);
+	#else
+	if (threads>1) {
+		LOGMSG("THREADS needs _MULTIENGINE. Jobs run one after another.\n");
 	}
+	sweep_worker(jobs,0);
+	#endif
+	
+	fclose(jobs->fsum);
+	LOGMSG2("\n%i sweep jobs done\n",jobs->anz);
 	
-	//followallgray(fn);
+	for(int32_t i=0;i<jobs->anz;i++) delete[] jobs->line[i];
+	delete[] jobs->line;
+	delete jobs;
+}
+
+// one box of seed values c in units of 2^-BASEDENOMINATOR (cmd=cbox)
+struct CBox {
+	int64_t re0,re1,im0,im1;
+	int32_t depth;
+	int32_t parent; // index, -1 for the root
+	char* rawfn; // result of the box, seed of its sub-boxes
+};
 
-	// free memory to get enough to allocate for the periodicty check
-	printf("freeing non-image memory ...\n");
-	freeRevCGMem();
+// the c-box of a C= or CD= parameter (already upper case), rounded
+// as parse_parameter does. Returns 0 if arg is neither
+int8_t parse_cbox(const char* arg,CBox& box) {
+	double r0,r1,i0,i1;
+	if (strstr(arg,"C=")==arg) {
+		if (sscanf(&arg[2],"%lf,%lf,%lf,%lf",&r0,&r1,&i0,&i1) == 4) {
+			r0=floor(r0*DENOM225);
+			r1=floor(r1*DENOM225);
+			i0=floor(i0*DENOM225);
+			i1=floor(i1*DENOM225);
+		} else
+		if (sscanf(&arg[2],"%lf,%lf",&r0,&i0) == 2) {
+			r0=r1=floor(r0*DENOM225);
+			i0=i1=floor(i0*DENOM225);
+		} else return 0;
+	} else
+	if (strstr(arg,"CD=")==arg) {
+		int a,b,c,d;
+		if (sscanf(&arg[3],"%i,%i,%i,%i",&a,&b,&c,&d) == 4) {
+			r0=a; r1=b; i0=c; i1=d;
+		} else
+		if (sscanf(&arg[3],"%i,%i",&a,&c) == 2) {
+			r0=r1=a;
+			i0=i1=c;
+		} else return 0;
+	} else return 0;
+	
+	box.re0=(int64_t)( (r0 < r1) ? r0 : r1 );
+	box.re1=(int64_t)( (r0 < r1) ? r1 : r0 );
+	box.im0=(int64_t)( (i0 < i1) ? i0 : i1 );
+	box.im1=(int64_t)( (i0 < i1) ? i1 : i0 );
+	
+	return 1;
+}
 
-	if (data5->pcscr) {
-		delete[] data5->pcscr;
-		data5->pcscr=NULL;
+// cmd=cbox,depth: computes the set for the c-box given by C= or CD=
+// and bisects the box recursively along its longer side. A sub-box
+// starts from the stored image of its parent: what is white or black
+// for every c of the parent is so for every c of the sub-box, only
+// the parent's gray pixels are propagated again. A box with interior
+// is not split further, nor is one at the given depth.
+// One summary line per box is appended to _cbox_summary.txt
+void run_cbox(const char* adepth,int32_t argc,char** argv) {
+	int32_t maxdepth=4;
+	int a;
+	if (sscanf(adepth,"%i",&a) == 1) maxdepth=a;
+	if (maxdepth < 0) maxdepth=0;
+	if (maxdepth > 24) maxdepth=24;
+	
+	int32_t memboxes=256;
+	CBox* boxes=new CBox[memboxes];
+	CBox& root=boxes[0];
+	root.re0=root.re1=root.im0=root.im1=0;
+	int8_t rootgiven=0;
+	char common[4096];
+	common[0]=0;
+	
+	// arguments are already upper case
+	for(int32_t i=1;i<argc;i++) {
+		if (strstr(argv[i],"CMD=CBOX")==argv[i]) continue;
+		if (parse_cbox(argv[i],root) > 0) {
+			rootgiven=1;
+			continue;
+		}
+		if ( (strlen(common)+strlen(argv[i])) > 4000) break;
+		strcat(common," ");
+		strcat(common,argv[i]);
 	}
-	if (data5->pcscrmgr) {
-		// frees the allocated screenrects
-		delete data5->pcscrmgr;
-		data5->pcscrmgr=NULL;
+	
+	if (
+		(rootgiven <= 0) ||
+		( (root.re0==root.re1) && (root.im0==root.im1) )
+	) {
+		LOGMSG("Error. cmd=cbox needs an interval C=re0,re1,im0,im1 or CD=...\n");
+		fatal_exit(99);
 	}
-
-	// data is now computed or loaded
-	if (cmd==CMD_PERIOD) {
-		if (interiorpresent>0) {
-			if (_PERIODICITYMETHOD==3) {
-				periodicity_m3(fn);
-				// data is no longer valid as potw has
-				// a different meaning there
+	// sub-boxes are passed as CD= integers
+	const int64_t CDMAX=((int64_t)1 << 31) - 1;
+	if (
+		(root.re0 < -CDMAX) || (root.re1 > CDMAX) ||
+		(root.im0 < -CDMAX) || (root.im1 > CDMAX)
+	) {
+		LOGMSG("Error. c-box too large for cmd=cbox.\n");
+		fatal_exit(99);
+	}
+	root.depth=0;
+	root.parent=-1;
+	root.rawfn=NULL;
+	
+	FILE *fsum=fopen("_cbox_summary.txt","at");
+	JuliaEngine engine;
+	int32_t anz=1,ctrinterior=0;
+	
+	// breadth first: a parent's raw data is stored before its
+	// sub-boxes are computed
+	for(int32_t b=0;b<anz;b++) {
+		char cd[256];
+		sprintf(cd,"CD=%i,%i,%i,%i",
+			(int)boxes[b].re0,(int)boxes[b].re1,
+			(int)boxes[b].im0,(int)boxes[b].im1);
+		LOGMSG4("\n=== c-box %i (depth %i): %s\n",b+1,boxes[b].depth,cd);
+		
+		engine.clearParameters();
+		engine.addParameter(common);
+		engine.addParameter(cd);
+		const int32_t parent=boxes[b].parent;
+		if ( (parent >= 0) && (boxes[parent].rawfn) ) {
+			// the parent's undecided pixels are stored as potw
+			engine.addParameter("RESETPOTW=1");
+			engine.freshstart=0;
+			strcpy(engine.infn,boxes[parent].rawfn);
+		} else {
+			engine.freshstart=1;
+		}
+		
+		int32_t ret=engine.run();
+		JobSummary& sum=engine.summary;
+		
+		boxes[b].rawfn=NULL;
+		if (engine.rawfn[0]) {
+			boxes[b].rawfn=new char[strlen(engine.rawfn)+1];
+			strcpy(boxes[b].rawfn,engine.rawfn);
+		}
+		
+		const int64_t wre=boxes[b].re1-boxes[b].re0;
+		const int64_t wim=boxes[b].im1-boxes[b].im0;
+		const char* state;
+		if (ret != 0) state="error";
+		else if (sum.interior > 0) {
+			state="interior";
+			ctrinterior++;
+		} else if (
+			(boxes[b].depth >= maxdepth) ||
+			( (wre < 2) && (wim < 2) )
+		) state="leaf";
+		else {
+			state="split";
+			if ( (anz+2) > memboxes) {
+				CBox* tmp=new CBox[2*memboxes];
+				memcpy(tmp,boxes,memboxes*sizeof(CBox));
+				delete[] boxes;
+				boxes=tmp;
+				memboxes *= 2;
+			}
+			// the halves share the bisecting line, c-boxes are closed
+			CBox& lo=boxes[anz];
+			CBox& hi=boxes[anz+1];
+			lo=hi=boxes[b];
+			if (wre >= wim) {
+				lo.re1=hi.re0=boxes[b].re0 + (wre >> 1);
 			} else {
-				periodicity(fn);
+				lo.im1=hi.im0=boxes[b].im0 + (wim >> 1);
 			}
-		} else {
-			LOGMSG("No interior present. Periodicity check skipped.\n");
+			lo.depth=hi.depth=boxes[b].depth+1;
+			lo.parent=hi.parent=b;
+			lo.rawfn=hi.rawfn=NULL;
+			anz += 2;
 		}
-	} 
+		
+		char cyc[1024];
+		summary_cycles(sum,cyc);
+		
+		fprintf(fsum,"%i\t%i\td%i\t%s\tL%02i\tinterior=%i\tgray=%I64d\tcycles=%s\tsec=%.1lf\tbbx=%I64d\t%s",
+			b+1,parent+1,boxes[b].depth,cd,sum.level,
+			sum.interior,sum.gray,cyc,
+			sum.sec,sum.bbx,state);
+		if (ret != 0) fprintf(fsum,"\terror=%i",ret);
+		fprintf(fsum,"\n");
+		fflush(fsum);
+	} // b
 	
-	delete data5;
+	fclose(fsum);
+	LOGMSG3("\n%i c-boxes computed, %i with interior\n",anz,ctrinterior);
 	
-	CLOCK1
+	for(int32_t b=0;b<anz;b++) {
+		if (boxes[b].rawfn) delete[] boxes[b].rawfn;
+	}
+	delete[] boxes;
+}
+
+int32_t main(int32_t argc,char** argv) {
+	flog=fopen("juliatsacoredyn.log.txt","at");
+	fprintf(flog,"\n-----------------\n");
+	printf("juliatsacoredyn\n");
+
+	#ifdef _USESPLITGRIDBBX
+	LOGMSG2("_USESPLITGRIDBBX %i\n",_SPLITBBX);
+	#endif
 	
-	LOGMSG2("%I64d bounding boxes calculated\n",ctrbbxfa);
+	JuliaEngine engine;
 	
-	delete helpermgr;
-	delete helperYdep;
-	delete helperXdep;
-	if (helper_doublemgr) delete helper_doublemgr;
-	if (helperYdep_double) delete helperYdep_double;
-	if (helperXdep_double) delete helperXdep_double;
+	for(int32_t i=1;i<argc;i++) {
+		// file names keep their case
+		char orig[1024];
+		strncpy(orig,argv[i],1000);
+		orig[1000]=0;
+		upper(argv[i]);
+		if (strstr(argv[i],"CMD=CONVERT")==argv[i]) {
+			convert_raw_into_newstructure();
+			fclose(flog);
+			return 0;
+		}
+		if ( (strstr(argv[i],"CMD=SWEEP")==argv[i]) && (strchr(orig,',')) ) {
+			for(int32_t k=i+1;k<argc;k++) upper(argv[k]);
+			run_sweep(strchr(orig,',')+1,argc,argv);
+			fclose(flog);
+			return 0;
+		}
+		if (strstr(argv[i],"CMD=CBOX")==argv[i]) {
+			for(int32_t k=i+1;k<argc;k++) upper(argv[k]);
+			const char* p=strchr(argv[i],',');
+			run_cbox(p ? p+1 : "",argc,argv);
+			fclose(flog);
+			return 0;
+		}
+		engine.addParameter(argv[i]);
+	} // i
+	
+	int32_t ret=engine.run();
 	
 	fclose(flog);
 	
-    return 0;
+    return ret;
 }
 